@@ -0,0 +1,130 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Bounded thread-safe cache of afterstate values keyed by a (Zobrist-style) hash of the afterstates.
+	/// The cache is "direct-mapped": each hash maps to a single slot, and newer entries overwrite older ones.
+	/// The slots are accessed without locks; an entry is stored as a pair of 64-bit words
+	/// ("key XOR data" and "data") so that entries torn by concurrent writes are detected and treated as misses.
+	/// Copies of the cache are empty (the content is tied to the particular instance of a neural net).
+	/// </summary>
+	class AfterstateValueCache
+	{
+		/// <summary>
+		/// Slot of the cache.
+		/// </summary>
+		struct Slot
+		{
+			/// <summary>
+			/// Key of the entry XOR-ed with its data.
+			/// </summary>
+			std::atomic<std::uint64_t> check{};
+
+			/// <summary>
+			/// Data of the entry (bit representation of the value).
+			/// </summary>
+			std::atomic<std::uint64_t> data{};
+		};
+
+		/// <summary>
+		/// Slots of the cache.
+		/// </summary>
+		std::unique_ptr<Slot[]> _slots{};
+
+		/// <summary>
+		/// Number of slots (a power of 2 or zero).
+		/// </summary>
+		std::size_t _capacity{};
+
+		/// <summary>
+		/// "Generation" of the cache; entries that were added during previous generations are considered invalid.
+		/// </summary>
+		std::atomic<std::uint64_t> _generation{1};
+
+		/// <summary>
+		/// Returns key of an entry with the given hash within the current generation.
+		/// </summary>
+		[[nodiscard]] std::uint64_t to_key(const std::uint64_t hash) const;
+
+	public:
+		/// <summary>
+		/// Default constructor (the cache is disabled).
+		/// </summary>
+		AfterstateValueCache() = default;
+
+		/// <summary>
+		/// Constructs an empty cache with (at least) the given number of slots.
+		/// </summary>
+		explicit AfterstateValueCache(const std::size_t capacity);
+
+		/// <summary>
+		/// Copy constructor (constructs an empty cache with the same capacity).
+		/// </summary>
+		AfterstateValueCache(const AfterstateValueCache& another_cache);
+
+		/// <summary>
+		/// Copy assignment (the current cache becomes empty with the same capacity as the given one).
+		/// </summary>
+		AfterstateValueCache& operator =(const AfterstateValueCache& another_cache);
+
+		/// <summary>
+		/// Re-allocates the cache so that it has (at least) the given number of slots (zero disables the cache).
+		/// All the entries get lost. Not thread-safe.
+		/// </summary>
+		void set_capacity(const std::size_t capacity);
+
+		/// <summary>
+		/// Returns number of slots in the cache.
+		/// </summary>
+		[[nodiscard]] std::size_t get_capacity() const;
+
+		/// <summary>
+		/// Returns "true" if the cache has non-zero capacity.
+		/// </summary>
+		[[nodiscard]] bool is_enabled() const;
+
+		/// <summary>
+		/// Invalidates all the entries of the cache (in constant time).
+		/// </summary>
+		void invalidate();
+
+		/// <summary>
+		/// Returns "true" and assigns the corresponding value to the output parameter
+		/// if the cache contains an entry with the given hash.
+		/// </summary>
+		bool try_get(const std::uint64_t hash, double& out_value) const;
+
+		/// <summary>
+		/// Adds an entry with the given hash and value to the cache (possibly overwriting another entry).
+		/// </summary>
+		void put(const std::uint64_t hash, const double value);
+
+		/// <summary>
+		/// Returns Zobrist-style hash of the given state (in its "standard" representation):
+		/// the hash is a XOR of (pseudo-random) keys of all the pairs "position - non-zero item value" of the state.
+		/// </summary>
+		[[nodiscard]] static std::uint64_t calc_hash(const std::vector<int>& state);
+	};
+}
@@ -0,0 +1,176 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "DenseLayerView.h"
+#include "StateConverter.h"
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Enumerates ways to evaluate the first layer of a net.
+	/// </summary>
+	enum class FirstLayerMode : int
+	{
+		// Each item of the batch is multiplied by the weight matrix
+		Dense = 0,
+		// Pre-activation of the first layer is calculated for the "base" item
+		// and then adjusted for each item of the batch with the weight columns
+		// that correspond to the elements in which the item differs from the "base" one
+		Incremental = 1,
+		// The first layer is fed directly from the sparse representations of the items
+		// (see "SparseState") so that the dense input is never materialized
+		Fused = 2,
+	};
+
+	/// <summary>
+	/// Functionality to evaluate a fully connected neural net on a batch of inputs
+	/// (arranged as rows of a matrix) by means of a single matrix-matrix product per layer.
+	/// Holds all the auxiliary memory so that in a "steady state" the evaluation does not allocate.
+	/// </summary>
+	class BatchNetEvaluator
+	{
+		/// <summary>
+		/// Views of the layers of the net that is being evaluated.
+		/// </summary>
+		std::vector<DenseLayerView> _layers{};
+
+		/// <summary>
+		/// Input matrix (row-major, one row per item of the batch).
+		/// </summary>
+		std::vector<DeepLearning::Real> _input{};
+
+		/// <summary>
+		/// "Base" item (used in the incremental evaluation mode, see "FirstLayerMode").
+		/// </summary>
+		std::vector<DeepLearning::Real> _base_item{};
+
+		/// <summary>
+		/// Pre-activation of the first layer on the "base" item.
+		/// </summary>
+		std::vector<DeepLearning::Real> _base_accumulator{};
+
+		/// <summary>
+		/// Sparse representations of the items (used in the "fused" evaluation mode, see "FirstLayerMode").
+		/// </summary>
+		std::vector<SparseState> _sparse_items{};
+
+		/// <summary>
+		/// Buffers to hold outputs of the layers (used in turns).
+		/// </summary>
+		std::vector<DeepLearning::Real> _buffers[2]{};
+
+		/// <summary>
+		/// Output values of the net (one per item of the batch).
+		/// </summary>
+		std::vector<double> _values{};
+
+		/// <summary>
+		/// Auxiliary container that can be used to hold "int-vector" representations of items of the batch before conversion.
+		/// </summary>
+		std::vector<int> _aux_state{};
+
+		/// <summary>
+		/// Number of items in the batch.
+		/// </summary>
+		int _batch_size{};
+
+		/// <summary>
+		/// Number of elements in each item of the batch.
+		/// </summary>
+		int _item_size{};
+
+		/// <summary>
+		/// Defines the way the first layer is evaluated.
+		/// </summary>
+		FirstLayerMode _first_layer_mode{ FirstLayerMode::Incremental };
+
+		/// <summary>
+		/// Calculates pre-activation of the given layer for the given number of items.
+		/// </summary>
+		static void act_linear(const DenseLayerView& layer, const DeepLearning::Real* in, const int items_count,
+			DeepLearning::Real* out);
+
+		/// <summary>
+		/// Calculates pre-activation of the given (first) layer for the whole batch
+		/// by adjusting pre-activation of the "base" item.
+		/// </summary>
+		void act_linear_incremental(const DenseLayerView& layer, DeepLearning::Real* out);
+
+		/// <summary>
+		/// Calculates pre-activation of the given (first) layer for the whole batch
+		/// using sparse representations of the items.
+		/// </summary>
+		void act_linear_sparse(const DenseLayerView& layer, DeepLearning::Real* out) const;
+
+	public:
+		/// <summary>
+		/// Prepares input matrix to accommodate the given number of items of the given size.
+		/// </summary>
+		void reset(const int batch_size, const int item_size);
+
+		/// <summary>
+		/// Returns pointer to the beginning of the input matrix row with the given index.
+		/// </summary>
+		DeepLearning::Real* item(const int item_id);
+
+		/// <summary>
+		/// Returns reference to the sparse representation of the item with the given index
+		/// (relevant only for the "fused" evaluation mode and is supposed to be filled by the caller after each call of "reset").
+		/// </summary>
+		SparseState& sparse_item(const int item_id);
+
+		/// <summary>
+		/// Returns pointer to the beginning of the "base" item (relevant only for the incremental
+		/// evaluation mode and is supposed to be filled by the caller after each call of "reset").
+		/// </summary>
+		DeepLearning::Real* base_item();
+
+		/// <summary>
+		/// Sets the way the first layer is evaluated.
+		/// </summary>
+		void set_first_layer_mode(const FirstLayerMode mode);
+
+		/// <summary>
+		/// Returns the way the first layer is evaluated.
+		/// </summary>
+		[[nodiscard]] FirstLayerMode get_first_layer_mode() const;
+
+		/// <summary>
+		/// Returns reference to the auxiliary container that can be used to hold
+		/// "int-vector" representations of items of the batch before conversion.
+		/// </summary>
+		std::vector<int>& aux_state();
+
+		/// <summary>
+		/// Evaluates the given net on the current batch; values of its (one-dimensional) output
+		/// are accessible via "values()" afterward.
+		/// </summary>
+		void evaluate(const DeepLearning::Net<DeepLearning::CpuDC>& net);
+
+		/// <summary>
+		/// Returns values calculated during the last call of "evaluate" method.
+		/// </summary>
+		[[nodiscard]] const std::vector<double>& values() const;
+
+		/// <summary>
+		/// Returns values calculated during the last call of "evaluate" method.
+		/// </summary>
+		[[nodiscard]] std::vector<double>& values();
+	};
+}
@@ -0,0 +1,130 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "DenseLayerView.h"
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Mini-batched forward and backward passes for fully connected nets with one-dimensional output.
+	/// The whole batch is propagated through each layer at once (matrix-matrix products), so that every
+	/// row of a weight matrix is loaded once per batch rather than once per item.
+	/// </summary>
+	class BatchNetTrainer
+	{
+		/// <summary>
+		/// Views of the layers of the net.
+		/// </summary>
+		std::vector<DenseLayerView> _layers{};
+
+		/// <summary>
+		/// Inputs of the batch (row-major, "batch size" rows by "input size" columns).
+		/// </summary>
+		std::vector<DeepLearning::Real> _inputs{};
+
+		/// <summary>
+		/// Pre-activations of the layers calculated during the last forward pass (row-major, one row per batch item).
+		/// </summary>
+		std::vector<std::vector<DeepLearning::Real>> _pre_activations{};
+
+		/// <summary>
+		/// Outputs (activations) of the layers calculated during the last forward pass (row-major, one row per batch item).
+		/// </summary>
+		std::vector<std::vector<DeepLearning::Real>> _activations{};
+
+		/// <summary>
+		/// Auxiliary buffers for the back-propagation pass (used in turns).
+		/// </summary>
+		std::vector<DeepLearning::Real> _deltas[2]{};
+
+		/// <summary>
+		/// Values of the net calculated during the last forward pass.
+		/// </summary>
+		std::vector<double> _values{};
+
+		/// <summary>
+		/// Shared buffer to hold the lambda-returns.
+		/// </summary>
+		std::vector<double> _returns{};
+
+		/// <summary>
+		/// Number of items in the batch.
+		/// </summary>
+		int _batch_size{};
+
+		/// <summary>
+		/// Size of a single input item.
+		/// </summary>
+		int _input_size{};
+
+		/// <summary>
+		/// Does the forward pass of the current inputs through the given net.
+		/// </summary>
+		void forward(const DeepLearning::Net<DeepLearning::CpuDC>& net);
+
+		/// <summary>
+		/// Adds "steps[i] * gradient_i" to the parameters of the given net, where "gradient_i" is the gradient
+		/// of the value of the net on the i-th input of the batch (with respect to the parameters).
+		/// Relies on the results of the last forward pass (which must be done on the same net).
+		/// </summary>
+		void backward(DeepLearning::Net<DeepLearning::CpuDC>& net, const std::vector<double>& steps);
+
+	public:
+		/// <summary>
+		/// Copies the given number of first tensors from the given collection into the batch of inputs.
+		/// </summary>
+		void assign_inputs(const std::vector<DeepLearning::CpuDC::tensor_t>& inputs, const int count);
+
+		/// <summary>
+		/// Assigns the batch of inputs from the given row-major matrix with the given number of rows.
+		/// </summary>
+		void assign_inputs(const std::vector<DeepLearning::Real>& inputs, const int count);
+
+		/// <summary>
+		/// Returns values of the given net on the current inputs.
+		/// </summary>
+		const std::vector<double>& evaluate(const DeepLearning::Net<DeepLearning::CpuDC>& net);
+
+		/// <summary>
+		/// Calculates lambda-returns of an episode: the i-th return is equal to
+		/// "rewards[i] + discount * ((1 - lambda) * values[i + 1] + lambda * returns[i + 1])"
+		/// with the last one equal to the last reward (the episode ends with a terminal state).
+		/// </summary>
+		static void calc_lambda_returns(const std::vector<double>& values, const std::vector<double>& rewards,
+			const int count, const double discount, const double lambda, std::vector<double>& out_returns);
+
+		/// <summary>
+		/// Treats the current inputs as a sequence of afterstates of an episode and does a single "offline" lambda-return
+		/// update of the given net: adds "learning_rate * (return_i - value_i) * gradient_i" summed over the episode
+		/// to the parameters of the net, where "value_i" and "gradient_i" are the value of the net on the i-th afterstate
+		/// and its gradient, while "return_i" is the lambda-return (see "calc_lambda_returns") built from the given rewards
+		/// (the i-th reward is the one received after the i-th afterstate).
+		/// </summary>
+		void td_lambda_return_update(DeepLearning::Net<DeepLearning::CpuDC>& net, const std::vector<double>& rewards,
+			const double learning_rate, const double discount, const double lambda);
+
+		/// <summary>
+		/// Adds "learning_rate * (targets[i] - value_i) * gradient_i" summed over the current inputs to the parameters
+		/// of the given net, where "value_i" and "gradient_i" are the value of the net on the i-th input and its gradient.
+		/// Returns the values of the net on the inputs (before the update).
+		/// </summary>
+		const std::vector<double>& regression_update(DeepLearning::Net<DeepLearning::CpuDC>& net,
+			const std::vector<double>& targets, const double learning_rate);
+	};
+}
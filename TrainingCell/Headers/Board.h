@@ -17,12 +17,17 @@
 
 #pragma once
 #include <array>
+#include <vector>
 #include "ITrainableAgent.h"
 #include "IStateSeed.h"
 #include "IState.h"
+#include "CoTask.h"
 
 namespace TrainingCell
 {
+	class EvaluationScheduler;
+	class EpisodeTrace;
+
 	/// <summary>
 	///	Callback to publish current state and move
 	/// </summary>
@@ -151,10 +156,21 @@ namespace TrainingCell
 		/// <param name="max_moves_without_capture">Maximal number of moves without capture to be qualified as a "draw".</param>
 		/// <param name="publish_state_callback">Callback to "publish" current state.</param>
 		/// <param name="cancel">Callback to request cancellation.</param>
+		/// <param name="trace">If not null, the taken moves are recorded into the trace.</param>
 		/// <returns>Result of the episode.</returns>
 		template <class A>
 		static EpisodeResult play_episode(IState& state, AgentManager<A>& agent_manager,
-			const int max_moves_without_capture, PublishStateCallBack publish_state_callback, CancelCallBack cancel);
+			const int max_moves_without_capture, PublishStateCallBack publish_state_callback, CancelCallBack cancel,
+			EpisodeTrace* trace = nullptr);
+
+		/// <summary>
+		/// "Replays" the recorded episode to the agents (so that they can train on it) and returns its result.
+		/// </summary>
+		/// <param name="trace">Record of the episode.</param>
+		/// <param name="final_state">Final state of the recorded episode.</param>
+		/// <param name="agent_manager">Access to the agents.</param>
+		template <class A>
+		static EpisodeResult replay_episode(EpisodeTrace& trace, const IState& final_state, AgentManager<A>& agent_manager);
 
 		/// <summary>
 		/// Retrieve move from the "current" agent and updates the "current" state accordingly.
@@ -163,10 +179,39 @@ namespace TrainingCell
 		/// in the "current state" before calling the method.
 		/// </summary>
 		template <class A>
-		static bool make_move(IState& state_handle, AgentManager<A>& agent_manager, PublishStateCallBack publish);
+		static bool make_move(IState& state_handle, AgentManager<A>& agent_manager, PublishStateCallBack publish,
+			EpisodeTrace* trace = nullptr);
+
+		/// <summary>
+		/// Updates the "current" state according to the move with the given ID chosen by the "current" agent
+		/// and passes the turn to the other agent. Returns "true" if the taken move was a "capture" one.
+		/// </summary>
+		template <class A>
+		static bool take_move(IState& state_handle, AgentManager<A>& agent_manager, const int chosen_move_id,
+			PublishStateCallBack publish);
+
+		/// <summary>
+		/// Notifies the agents about the end of the episode played on the given (final) state and returns result of the episode.
+		/// </summary>
+		template <class A>
+		static EpisodeResult finish_episode(const IState& state, AgentManager<A>& agent_manager);
+
+		/// <summary>
+		/// Coroutine that plays episodes with the given pair of agents while the shared counter of episodes
+		/// to play is positive; the moves are taken via the coroutine version of "make_move" of the agents.
+		/// </summary>
+		static CoTask<void> play_episodes_async(IMinimalAgent* const agent_white_ptr, IMinimalAgent* const agent_black_ptr,
+			int& episodes_to_play, const IStateSeed& start_state, const int max_moves_without_capture,
+			EvaluationScheduler& scheduler, int& blacks_win_counter, int& whites_win_counter);
 
 	public:
 
+		/// <summary>
+		/// Default number of consequent draw episodes that results in using of a draw outcome episode
+		/// for training (see the corresponding parameter of "train()").
+		/// </summary>
+		static constexpr int DefaultMaxConsequentDrawEpisodes = 100;
+
 		/// <summary>
 		/// Data struct to represent playing statistics.
 		/// </summary>
@@ -256,9 +301,26 @@ namespace TrainingCell
 		/// <param name="publish_end_episode_stats_callback">Callback to be called after each episode (game). Allows caller to get some intermediate information about the process</param>
 		/// <param name="cancel">Callback allowing caller to cancel the process</param>
 		/// <param name="error">Callback allowing caller to get some information about errors encountered</param>
+		/// <param name="single_pass">If "true", afterstates of the exploration episode are recorded (see "EpisodeTrace")
+		/// and the agents are trained on the record instead of a re-play of the episode. The training results are the same,
+		/// but agents that need access to the seeds of states (e.g., those doing TD-search) can't be trained this way.</param>
 		static Stats train(ITrainableAgent* const agent_white_ptr, ITrainableAgent* const agent_black_ptr,
 			const int episodes, const IStateSeed& start_state, const int max_moves_without_capture = 200,
-			const int  max_consequent_draw_episodes = 100, PublishEndEpisodeStatsCallBack publish_end_episode_stats_callback = nullptr,
-			CancelCallBack cancel = nullptr, ErrorMessageCallBack error = nullptr);
+			const int  max_consequent_draw_episodes = DefaultMaxConsequentDrawEpisodes, PublishEndEpisodeStatsCallBack publish_end_episode_stats_callback = nullptr,
+			CancelCallBack cancel = nullptr, ErrorMessageCallBack error = nullptr, const bool single_pass = false);
+
+		/// <summary>
+		///	Runs the given number of episodes (games) concurrently (in the calling thread) with the given pairs of agents,
+		/// one game per pair at a time. The games are played as coroutines (see "IMinimalAgent::make_move_async"),
+		/// so that evaluation requests of all the games get evaluated in batches by the given scheduler.
+		/// The pairs must not share agents that keep per-game state (e.g., eligibility traces).
+		/// </summary>
+		/// <param name="agent_pairs">Pairs of agents ("white" one first) to play the games.</param>
+		/// <param name="episodes">Number of episodes (games) to play in total</param>
+		/// <param name="start_state">State from which each episode (game) should be started</param>
+		/// <param name="max_moves_without_capture">Defines maximal number of moves without a capture that will be qualified as a "draw"</param>
+		/// <param name="scheduler">Batched inference back end.</param>
+		static Stats play(const std::vector<std::array<IMinimalAgent*, 2>>& agent_pairs, const int episodes,
+			const IStateSeed& start_state, const int max_moves_without_capture, EvaluationScheduler& scheduler);
 	};
 }
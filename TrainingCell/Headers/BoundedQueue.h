@@ -0,0 +1,172 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <utility>
+#include <cstddef>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Bounded lock-free multi-producer multi-consumer FIFO queue (ring buffer of "sequenced" slots).
+	/// Items are exchanged with the slots by swapping, so that the memory owned by the items
+	/// (e.g., by vectors they contain) gets recycled between producers and consumers.
+	/// </summary>
+	template <class T>
+	class BoundedQueue
+	{
+		/// <summary>
+		/// Slot of the ring buffer.
+		/// </summary>
+		struct Slot
+		{
+			/// <summary>
+			/// Sequence number that tells whether the slot is ready to be written or read at the current "lap".
+			/// </summary>
+			std::atomic<std::size_t> sequence{};
+
+			/// <summary>
+			/// Item.
+			/// </summary>
+			T item{};
+		};
+
+		/// <summary>
+		/// Size of cache line (used to avoid false sharing of the positions).
+		/// </summary>
+		static constexpr std::size_t CacheLineSize = 64;
+
+		/// <summary>
+		/// Slots.
+		/// </summary>
+		std::unique_ptr<Slot[]> _slots{};
+
+		/// <summary>
+		/// Capacity minus one (capacity is a power of two).
+		/// </summary>
+		std::size_t _mask{};
+
+		/// <summary>
+		/// Position to push the next item to.
+		/// </summary>
+		alignas(CacheLineSize) std::atomic<std::size_t> _push_pos{};
+
+		/// <summary>
+		/// Position to pop the next item from.
+		/// </summary>
+		alignas(CacheLineSize) std::atomic<std::size_t> _pop_pos{};
+
+	public:
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="capacity">Minimal capacity of the queue (gets rounded up to the nearest power of two).</param>
+		explicit BoundedQueue(const std::size_t capacity)
+		{
+			const auto actual_capacity = std::bit_ceil(capacity < 2 ? 2 : capacity);
+			_slots = std::make_unique<Slot[]>(actual_capacity);
+			_mask = actual_capacity - 1;
+
+			for (auto slot_id = 0ull; slot_id < actual_capacity; ++slot_id)
+				_slots[slot_id].sequence.store(slot_id, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Copying is prohibited.
+		/// </summary>
+		BoundedQueue(const BoundedQueue&) = delete;
+
+		/// <summary>
+		/// Assignment is prohibited.
+		/// </summary>
+		BoundedQueue& operator =(const BoundedQueue&) = delete;
+
+		/// <summary>
+		/// Returns capacity of the queue.
+		/// </summary>
+		[[nodiscard]] std::size_t capacity() const
+		{
+			return _mask + 1;
+		}
+
+		/// <summary>
+		/// Tries to push the given item to the queue; returns "false" if the queue is full.
+		/// In case of success the item gets swapped with the content of the slot it was pushed to
+		/// (so that the caller receives an "unspecified" item with possibly preallocated memory).
+		/// </summary>
+		bool try_push(T& item)
+		{
+			auto pos = _push_pos.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				auto& slot = _slots[pos & _mask];
+				const auto sequence = slot.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+				if (diff == 0)
+				{
+					if (_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						std::swap(slot.item, item);
+						slot.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+					return false;
+				else
+					pos = _push_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		/// <summary>
+		/// Tries to pop an item from the queue to the given container; returns "false" if the queue is empty.
+		/// In case of success the previous content of the container gets stored in the released slot
+		/// (so that its memory can be reused by producers).
+		/// </summary>
+		bool try_pop(T& out_item)
+		{
+			auto pos = _pop_pos.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				auto& slot = _slots[pos & _mask];
+				const auto sequence = slot.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+				if (diff == 0)
+				{
+					if (_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						std::swap(slot.item, out_item);
+						slot.sequence.store(pos + _mask + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+					return false;
+				else
+					pos = _pop_pos.load(std::memory_order_relaxed);
+			}
+		}
+	};
+}
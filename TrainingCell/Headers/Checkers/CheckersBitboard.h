@@ -0,0 +1,121 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include "CheckersState.h"
+
+namespace TrainingCell::Checkers
+{
+	/// <summary>
+	/// "Bitboard" representation of a checkers state that is used to generate moves,
+	/// bit with index "i" of each mask corresponds to the field with plain ID "i" (see "CheckersState").
+	/// The moves are generated in exactly the same order as the one of the "reference" (array-based) generator
+	/// implemented in "CheckersState".
+	/// </summary>
+	class CheckersBitboard
+	{
+		/// <summary>
+		/// Fields occupied by the "ally" men.
+		/// </summary>
+		std::uint32_t _men{};
+
+		/// <summary>
+		/// Fields occupied by the "ally" kings.
+		/// </summary>
+		std::uint32_t _kings{};
+
+		/// <summary>
+		/// Fields occupied by the opponent's pieces (men or kings).
+		/// </summary>
+		std::uint32_t _opponents{};
+
+		/// <summary>
+		/// Empty fields.
+		/// </summary>
+		std::uint32_t _empty{};
+
+		/// <summary>
+		/// Number of diagonal directions.
+		/// </summary>
+		static constexpr int DirectionsCount = 4;
+
+		/// <summary>
+		/// Returns the given mask shifted one field in the given diagonal direction (the bits that leave the board are dropped).
+		/// Directions are enumerated in the order they are traversed by the "reference" generator:
+		/// 0 - row decreases, column increases; 1 - row increases, column decreases;
+		/// 2 - row and column decrease; 3 - row and column increase.
+		/// </summary>
+		static std::uint32_t shift(const std::uint32_t mask, const int direction_id);
+
+		/// <summary>
+		/// Returns "true" if the given direction is "backward" (i.e., not available for non-capturing moves of men).
+		/// </summary>
+		static bool is_backward(const int direction_id);
+
+		/// <summary>
+		/// Returns "true" if at least one capturing move is available in the current state.
+		/// </summary>
+		[[nodiscard]] bool has_captures() const;
+
+		/// <summary>
+		/// Appends all the capturing moves (including the "partial" capture chains) of the piece that started its move at the field
+		/// with the given ID and is currently located on the field with the given ID, having captured the given pieces.
+		/// </summary>
+		/// <param name="start_id">ID of the field where the move started.</param>
+		/// <param name="field_id">ID of the field where the piece is currently located.</param>
+		/// <param name="is_man">"True" if the moving piece is a man.</param>
+		/// <param name="empty">Empty fields (the captured pieces are not removed until the move is over).</param>
+		/// <param name="capturable">Fields occupied by the opponent's pieces that have not been captured yet.</param>
+		/// <param name="captures">Stack of fields captured so far.</param>
+		/// <param name="captures_count">Number of fields captured so far.</param>
+		/// <param name="out_result">Collection to append the moves to.</param>
+		static void append_capture_chains(const int start_id, const int field_id, const bool is_man,
+			const std::uint32_t empty, const std::uint32_t capturable,
+			std::array<PiecePosition, CheckersMove::MaxCapturesCount>& captures, const int captures_count,
+			CheckersState::MoveList& out_result);
+
+		/// <summary>
+		/// Returns position on the board that corresponds to the field with the given ID.
+		/// </summary>
+		static PiecePosition to_position(const int field_id);
+
+	public:
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		explicit CheckersBitboard(const CheckersState& state);
+
+		/// <summary>
+		/// Fills the given collection with all the capturing moves available in the state.
+		/// </summary>
+		void get_capturing_moves(CheckersState::MoveList& out_result) const;
+
+		/// <summary>
+		/// Fills the given collection with all the non-capturing moves available in the state.
+		/// </summary>
+		void get_non_capturing_moves(CheckersState::MoveList& out_result) const;
+
+		/// <summary>
+		/// Fills the given collection with all the moves available in the state
+		/// (capturing moves if there are any, non-capturing moves otherwise).
+		/// </summary>
+		void get_moves(CheckersState::MoveList& out_result) const;
+	};
+}
@@ -18,6 +18,7 @@
 #pragma once
 #include <vector>
 #include "../PiecePosition.h"
+#include "../InlineVector.h"
 
 namespace TrainingCell
 {
@@ -33,6 +34,16 @@ namespace TrainingCell::Checkers
 	class CheckersMove
 	{
 		friend class CheckersState;
+		friend class CheckersBitboard;
+
+	public:
+
+		/// <summary>
+		/// Maximal number of pieces that can be captured within a single move.
+		/// </summary>
+		static constexpr int MaxCapturesCount = 12;
+
+	private:
 
 		/// <summary>
 		/// Start position of the move.
@@ -45,9 +56,10 @@ namespace TrainingCell::Checkers
 		PiecePosition finish{};
 
 		/// <summary>
-		/// Coordinate of captured pieces ordered from start position to the finish position of the move.
+		/// Coordinate of captured pieces ordered from start position to the finish position of the move
+		/// (stored inline, so that moves never touch the heap).
 		/// </summary>
-		std::vector<PiecePosition> captures{};
+		InlineVector<PiecePosition, MaxCapturesCount> captures{};
 
 		/// <summary>
 		/// Appends "continuation" to the current move.
@@ -83,6 +83,18 @@ namespace TrainingCell::Checkers
 	/// </summary>
 	class CheckersState : public State_array, public IStateSeed
 	{
+	public:
+
+		/// <summary>
+		/// Collection of moves. A move takes about 256 bytes (because of its inline captures),
+		/// so the inline buffer of the list takes about 8 KB (and so does every state handle that keeps a list of actions).
+		/// The inline capacity covers the branching factors met in random playouts from the start state (at most 31);
+		/// positions with more moves (e.g., artificial ones with many "kings") make the list spill to the heap.
+		/// </summary>
+		using MoveList = InlineVector<CheckersMove, 32>;
+
+	private:
+
 		bool _inverted{};
 
 		/// <summary>
@@ -155,17 +167,17 @@ namespace TrainingCell::Checkers
 		/// <summary>
 		/// Fills the given collection with all the capturing moves available for the given state.
 		/// </summary>
-		static void get_capturing_moves(const CheckersState& current_state, std::vector<CheckersMove>& out_result);
+		static void get_capturing_moves(const CheckersState& current_state, MoveList& out_result);
 
 		/// <summary>
 		/// Fills the given collection with all the non-capturing moves available for the given state.
 		/// </summary>
-		static void get_non_capturing_moves(const CheckersState& current_state, std::vector<CheckersMove>& out_result);
+		static void get_non_capturing_moves(const CheckersState& current_state, MoveList& out_result);
 
 		/// <summary>
 		/// Fills the given collection with all the available moves for the given state.
 		/// </summary>
-		static void get_moves(const CheckersState& current_state, std::vector<CheckersMove>& out_result);
+		static void get_moves(const CheckersState& current_state, MoveList& out_result);
 
 		/// <summary>
 		/// Returns a piece position that is achieved from the given one by moving for the given (signed) number of steps
@@ -318,6 +330,12 @@ namespace TrainingCell::Checkers
 		/// </summary>
 		[[nodiscard]] std::vector<int> get_vector(const CheckersMove& move) const;
 
+		/// <summary>
+		/// Writes "int-vector" representation of the current state after given `move` was "applied" to it
+		/// into the given container (which gets resized if needed).
+		/// </summary>
+		void get_vector(const CheckersMove& move, std::vector<int>& out_result) const;
+
 		/// <summary>
 		/// Returns 64 element long "int-vector" representation of the current state after it
 		/// was first "transformed" by the given `move` and then inverted.
@@ -350,6 +368,11 @@ namespace TrainingCell::Checkers
 		/// </summary>
 		[[nodiscard]] std::vector<int> to_vector() const;
 
+		/// <summary>
+		/// Writes "int-vector" representation of the state into the given container (which gets resized if needed).
+		/// </summary>
+		void to_vector(std::vector<int>& out_result) const;
+
 		/// <summary>
 		/// Returns size of the state represented as a vector of integers delivered by `to_vector()` method;
 		/// </summary>
@@ -368,13 +391,19 @@ namespace TrainingCell::Checkers
 		/// <summary>
 		/// Returns collection of available moves for the current state.
 		/// </summary>
-		[[nodiscard]] std::vector<CheckersMove> get_moves() const;
+		[[nodiscard]] MoveList get_moves() const;
 
 		/// <summary>
 		/// Fills the given collection with available moves for the current state.
 		/// Returns "true" if the current state is a "draw".
 		/// </summary>
-		virtual bool get_moves(std::vector<CheckersMove>& out_result) const;
+		virtual bool get_moves(MoveList& out_result) const;
+
+		/// <summary>
+		/// Fills the given collection with available moves for the current state using the "reference" (array-based) generator.
+		/// The moves are the same (and come in the same order) as the ones returned by "get_moves()" which relies on the "bitboard" generator.
+		/// </summary>
+		void get_moves_reference(MoveList& out_result) const;
 
 		/// <summary>
 		/// Equality operator.
@@ -391,6 +420,11 @@ namespace TrainingCell::Checkers
 		/// </summary>
 		[[nodiscard]] std::unique_ptr<IState> yield(const bool initialize_recorder) const override;
 
+		/// <summary>
+		/// See documentation of the base class.
+		/// </summary>
+		void yield(std::unique_ptr<IState>& state_ptr, const bool initialize_recorder) const override;
+
 		/// <summary>
 		/// Returns type identifier of the state.
 		/// </summary>
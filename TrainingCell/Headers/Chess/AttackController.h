@@ -17,8 +17,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include "../PiecePosition.h"
+#include "../Checkerboard.h"
 
 namespace TrainingCell::Chess
 {
@@ -57,6 +60,11 @@ namespace TrainingCell::Chess
 		/// </summary>
 		static constexpr int BitMask = (1 << TotalBitsCount) - 1;
 
+		/// <summary>
+		/// Number of different direction vectors (8 "straight" ones and 8 "knight" ones).
+		/// </summary>
+		static constexpr int RaysPerFieldCount = 16;
+
 	public:
 
 		/// <summary>
@@ -79,21 +87,50 @@ namespace TrainingCell::Chess
 			/// </summary>
 			int token;
 
+			/// <summary>
+			/// Index of the direction vector in the table of "rays" (see "get_ray()").
+			/// Vectors with indices "i" and "i ^ 1" are opposite to each other.
+			/// </summary>
+			int ray_id{ -1 };
+
 			/// <summary>
 			/// Returns "true" if the increment can be applied more than once, i.e., the attack direction is "long-range".
 			/// </summary>
 			bool is_long_range() const;
+		};
+
+		/// <summary>
+		/// Sequence of fields that are passed when moving from a certain field along a certain direction vector until the edge of the board.
+		/// </summary>
+		struct Ray
+		{
+			/// <summary>
+			/// IDs of the fields (in the order they are passed).
+			/// </summary>
+			std::array<int, Checkerboard::Rows - 1> field_ids{};
+
+			/// <summary>
+			/// Number of the fields in the ray.
+			/// </summary>
+			int length{};
 
 			/// <summary>
-			/// Returns "true" if the given "end" position can be "reached" by
-			/// adding (subtracting) sufficient number of current direction vectors to (from) "start" position,
-			/// in which case `out_param` contains the corresponding multiplier.
-			///	Returns "false" otherwise (in which case value of `out_param` should be discarded).
-			///	IMPORTANT: in case the current attack direction is not a "long range" one, the only possible value of "out_param" is "1".
+			/// Bit-mask of the fields in the ray (bit index is equal to the field ID).
 			/// </summary>
-			bool can_reach(const PiecePosition& start, const PiecePosition& end, int& out_param) const;
+			std::uint64_t fields_mask{};
 		};
 
+		/// <summary>
+		/// Returns the "ray" that starts (exclusively) at the field with the given ID and goes along the direction vector
+		/// with the given index (see "Direction::ray_id"), or along the opposite one if "opposite" is "true".
+		/// </summary>
+		const Ray& get_ray(const int field_id, const int ray_id, const bool opposite = false) const;
+
+		/// <summary>
+		/// Returns the instance of the controller shared by all the chess states.
+		/// </summary>
+		static const AttackController& instance();
+
 		/// <summary>
 		/// Returns collection of all the possible attack move directions for the given piece represented with its token.
 		/// </summary>
@@ -112,7 +149,7 @@ namespace TrainingCell::Chess
 		/// <summary>
 		/// Decodes only long range attack directions from the given encoded attack directions.
 		/// </summary>
-		std::vector<Direction> decode_long_range_attack_directions(const int encoded_attack_directions) const;
+		const std::vector<Direction>& decode_long_range_attack_directions(const int encoded_attack_directions) const;
 
 		/// <summary>
 		/// Returns a "compressed" version of the attack directions encoded as lowest 24 bits of the input integer.
@@ -123,7 +160,7 @@ namespace TrainingCell::Chess
 		/// <summary>
 		/// Constructor.
 		/// </summary>
-		AttackController() = default;
+		AttackController();
 
 	private:
 
@@ -131,42 +168,42 @@ namespace TrainingCell::Chess
 		/// All the possible long-range straight attack directions.
 		/// </summary>
 		std::vector<Direction> _queen_directions{
-			{ { 1, 0 }, 1 << 0 },
-			{ { -1, 0 }, 1 << 1 },
-			{ { 0, 1 }, 1 << 2 },
-			{ { 0, -1 }, 1 << 3 },
-			{ { 1, 1 }, 1 << 4 },
-			{ { -1, -1 }, 1 << 5 },
-			{ { -1, 1 }, 1 << 6 },
-			{ { 1, -1 }, 1 << 7 },
+			{ { 1, 0 }, 1 << 0, 0 },
+			{ { -1, 0 }, 1 << 1, 1 },
+			{ { 0, 1 }, 1 << 2, 2 },
+			{ { 0, -1 }, 1 << 3, 3 },
+			{ { 1, 1 }, 1 << 4, 4 },
+			{ { -1, -1 }, 1 << 5, 5 },
+			{ { -1, 1 }, 1 << 6, 6 },
+			{ { 1, -1 }, 1 << 7, 7 },
 		};
 
 		/// <summary>
 		/// All the possible short-range attack directions.
 		/// </summary>
 		std::vector<Direction> _king_directions{
-			{ { 1, 0 }, 1 << BitsPerDirectionGroup },
-			{ { -1, 0 }, 1 << (BitsPerDirectionGroup + 1) },
-			{ { 0, 1 }, 1 << (BitsPerDirectionGroup + 2) },
-			{ { 0, -1 }, 1 << (BitsPerDirectionGroup + 3) },
-			{ { 1, 1 }, 1 << (BitsPerDirectionGroup + 4) },
-			{ { -1, -1 }, 1 << (BitsPerDirectionGroup + 5) },
-			{ { -1, 1 }, 1 << (BitsPerDirectionGroup + 6) },
-			{ { 1, -1 }, 1 << (BitsPerDirectionGroup + 7) },
+			{ { 1, 0 }, 1 << BitsPerDirectionGroup, 0 },
+			{ { -1, 0 }, 1 << (BitsPerDirectionGroup + 1), 1 },
+			{ { 0, 1 }, 1 << (BitsPerDirectionGroup + 2), 2 },
+			{ { 0, -1 }, 1 << (BitsPerDirectionGroup + 3), 3 },
+			{ { 1, 1 }, 1 << (BitsPerDirectionGroup + 4), 4 },
+			{ { -1, -1 }, 1 << (BitsPerDirectionGroup + 5), 5 },
+			{ { -1, 1 }, 1 << (BitsPerDirectionGroup + 6), 6 },
+			{ { 1, -1 }, 1 << (BitsPerDirectionGroup + 7), 7 },
 		};
 
 		/// <summary>
 		/// All the possible knight attack directions.
 		/// </summary>
 		std::vector<Direction> _knight_directions{
-			{ { 1, 2 }, 1 << (2 * BitsPerDirectionGroup) },
-			{ { -1, -2 }, 1 << (2 * BitsPerDirectionGroup + 1) },
-			{ { 2, 1 }, 1 << (2 * BitsPerDirectionGroup + 2) },
-			{ { -2, -1 }, 1 << (2 * BitsPerDirectionGroup + 3) },
-			{ { -1, 2 }, 1 << (2 * BitsPerDirectionGroup + 4) },
-			{ { 1, -2 }, 1 << (2 * BitsPerDirectionGroup + 5) },
-			{ { -2, 1 }, 1 << (2 * BitsPerDirectionGroup + 6) },
-			{ { 2, -1 }, 1 << (2 * BitsPerDirectionGroup + 7) },
+			{ { 1, 2 }, 1 << (2 * BitsPerDirectionGroup), 8 },
+			{ { -1, -2 }, 1 << (2 * BitsPerDirectionGroup + 1), 9 },
+			{ { 2, 1 }, 1 << (2 * BitsPerDirectionGroup + 2), 10 },
+			{ { -2, -1 }, 1 << (2 * BitsPerDirectionGroup + 3), 11 },
+			{ { -1, 2 }, 1 << (2 * BitsPerDirectionGroup + 4), 12 },
+			{ { 1, -2 }, 1 << (2 * BitsPerDirectionGroup + 5), 13 },
+			{ { -2, 1 }, 1 << (2 * BitsPerDirectionGroup + 6), 14 },
+			{ { 2, -1 }, 1 << (2 * BitsPerDirectionGroup + 7), 15 },
 		};
 
 		/// <summary>
@@ -204,5 +241,20 @@ namespace TrainingCell::Chess
 				_queen_directions[2],
 				_queen_directions[3]
 		};
+
+		/// <summary>
+		/// Direction vectors indexed by their "ray" IDs.
+		/// </summary>
+		std::array<PiecePosition, RaysPerFieldCount> _ray_vectors{};
+
+		/// <summary>
+		/// Precomputed "rays" for each field of the board and each direction vector.
+		/// </summary>
+		std::array<std::array<Ray, RaysPerFieldCount>, Checkerboard::FieldsCount> _rays{};
+
+		/// <summary>
+		/// Precomputed collections of long-range attack directions for each possible combination of the corresponding bits.
+		/// </summary>
+		std::array<std::vector<Direction>, LongRangeDirGroupMask + 1> _long_range_directions{};
 	};
 }
\ No newline at end of file
@@ -17,12 +17,13 @@
 
 #pragma once
 #include <array>
-#include <functional>
+#include <cstdint>
 
 #include "AttackController.h"
 #include "ChessMove.h"
 #include "../Checkerboard.h"
 #include "../IStateSeed.h"
+#include "../InlineVector.h"
 
 namespace TrainingCellTest
 {
@@ -38,6 +39,16 @@ namespace TrainingCell::Chess
 	{
 		friend class TrainingCellTest::ChessStateTest; // for diagnostics purposes
 
+	public:
+
+		/// <summary>
+		/// Collection of moves. Its inline capacity is equal to the maximal number of legal moves
+		/// that can be available in a chess position (218), so it does not spill to the heap in practice.
+		/// </summary>
+		using MoveList = InlineVector<ChessMove, 218>;
+
+	private:
+
 		/// <summary>
 		/// Representation of a single checkerboard field.
 		/// </summary>
@@ -98,47 +109,65 @@ namespace TrainingCell::Chess
 		std::array<Field, Checkerboard::FieldsCount> _data;
 
 		/// <summary>
-		/// A flag to track if the current state is inverted with respect to the initial state.
+		/// Legality constraints for the moves of the "non-king" ally pieces in a certain position.
 		/// </summary>
-		bool _is_inverted {false};
+		struct MoveConstraints
+		{
+			/// <summary>
+			/// Bit-mask of the fields (bit index is equal to the field ID) where a "non-king" piece can finish its move
+			/// so that the king is not left under the check (all the fields if the king is not under check; no fields in case of a double check).
+			/// </summary>
+			std::uint64_t evasion_fields{};
+
+			/// <summary>
+			/// Bit-mask of the fields occupied by the "pinned" ally pieces.
+			/// </summary>
+			std::uint64_t pinned_fields{};
+
+			/// <summary>
+			/// Bit-masks of the lines along which the "pinned" pieces can move (only the items corresponding to the pinned fields are relevant).
+			/// </summary>
+			std::array<std::uint64_t, Checkerboard::FieldsCount> pin_lines{};
+
+			/// <summary>
+			/// Returns bit-mask of the fields where the ally piece located on the field with the given ID can finish its move.
+			/// </summary>
+			[[nodiscard]] std::uint64_t get_allowed_fields(const int field_id) const;
+		};
 
 		/// <summary>
-		/// An instance of attack controller.
+		/// A flag to track if the current state is inverted with respect to the initial state.
 		/// </summary>
-		AttackController _attack_controller{};
+		bool _is_inverted {false};
 
 		/// <summary>
-		/// "Commits" attacks suggested by the given collection with respect to the given position on the board.
+		/// Returns the instance of attack controller (shared by all the chess states).
 		/// </summary>
-		void commit_attack(const std::vector<AttackController::Direction>& attack_directions, const PiecePosition& position, const bool rival);
+		static const AttackController& attack_controller();
 
 		/// <summary>
-		/// "Withdraws" attacks suggested by the given collection with respect to the given position on the board.
+		/// "Commits" attacks suggested by the given collection with respect to the field with the given ID.
 		/// </summary>
-		void withdraw_attack(const std::vector<AttackController::Direction>& attack_directions, const PiecePosition& position, const bool rival);
+		void commit_attack(const std::vector<AttackController::Direction>& attack_directions, const int field_id, const bool rival);
 
 		/// <summary>
-		/// "Commits" or "withdraws" attacks suggested by the given collection with respect
-		/// to the given position of the board depending on the operation callback. 
+		/// "Withdraws" attacks suggested by the given collection with respect to the field with the given ID.
 		/// </summary>
-		void process_attack(const std::vector<AttackController::Direction>& attack_directions, const PiecePosition& position, const bool negate_dir,
-			const std::function<void(Field&, const int)>& operation);
+		void withdraw_attack(const std::vector<AttackController::Direction>& attack_directions, const int field_id, const bool rival);
 
 		/// <summary>
-		/// Returns "true" if the given "king" position is threatened after the move with the given start and finish positions is done.
+		/// "Commits" or "withdraws" attacks suggested by the given collection with respect
+		/// to the field with the given ID depending on the operation callback.
 		/// </summary>
-		[[nodiscard]] bool is_king_threatened_after_move(const PiecePosition& move_start_pos,
-		                                                 const PiecePosition& move_finish_pos,
-		                                                 const PiecePosition& king_field_pos) const;
+		template <class Op>
+		void process_attack(const std::vector<AttackController::Direction>& attack_directions, const int field_id, const bool negate_dir,
+			const Op& operation);
 
 		/// <summary>
-		/// Returns attack token of a single attack direction from the given collection that affects the given "focus field" when applied from the given "source position".
-		///	Returns "0" if no such attack direction exists in the given collection.
-		///	IMPORTANT: it is assumed that only one attack direction from the given collection can point towards the given focus field.
-		///	It is responsibility of a caller to ensure that both given positions are valid positions on a checkerboard.
+		/// Returns constraints that the moves of "non-king" ally pieces must satisfy in order not to leave
+		/// the ally king (located on the field with the given ID) under the check.
 		/// </summary>
-		[[nodiscard]] int get_rival_attack_on_field(const std::vector<AttackController::Direction>& rival_attack_directions,
-		                                            const PiecePosition& source_position, const PiecePosition& focus_field_pos) const;
+		[[nodiscard]] MoveConstraints get_move_constraints(const int king_field_id) const;
 
 		/// <summary>
 		/// Builds the attack field from the given board state.
@@ -166,16 +195,24 @@ namespace TrainingCell::Chess
 		/// </summary>
 		/// <param name="king_field_id">Index of the field where "King" piece is located.</param>
 		/// <param name="moves">Collection to append to.</param>
-		void append_king_moves(const int king_field_id, std::vector<ChessMove>& moves) const;
+		void append_king_moves(const int king_field_id, MoveList& moves) const;
+
+		/// <summary>
+		/// Appends the given move of a pawn to the given collection
+		/// (as a group of "promotion" moves, one per each promotion option, if "promotion" is "true").
+		/// </summary>
+		static void append_pawn_move(MoveList& moves, const int start_field_id, const int finish_field_id,
+			const bool captures, const bool promotion);
 
 		/// <summary>
 		/// Appends moves of the pawn located on the field with the given ID to the given collection of moves.
-		///	Does not take care of the proper handling of "promotion" moves.
 		/// </summary>
 		/// <param name="pawn_field_id">Index of a field where an "ally pawn" piece is located.</param>
 		/// <param name="moves">Collection of moves to append to.</param>
-		/// <param name="king_pos">Current position of the "ally king".</param>
-		void append_pawn_moves_basic(const int pawn_field_id, std::vector<ChessMove>& moves, const PiecePosition& king_pos) const;
+		/// <param name="allowed_fields">Bit-mask of the fields where the pawn can finish its move (see "MoveConstraints").</param>
+		/// <param name="promotion">If "true" each move of the pawn is appended as a group of "promotion" moves.</param>
+		void append_pawn_moves_basic(const int pawn_field_id, MoveList& moves, const std::uint64_t allowed_fields,
+			const bool promotion) const;
 
 		/// <summary>
 		/// Appends moves of the pawn located on the field with the given ID to the given collection of moves.
@@ -183,25 +220,17 @@ namespace TrainingCell::Chess
 		/// </summary>
 		/// <param name="pawn_field_id">Index of a field where an "ally pawn" piece is located.</param>
 		/// <param name="moves">Collection of moves to append to.</param>
-		/// <param name="king_pos">Current position of the "ally king".</param>
-		void append_pawn_moves(const int pawn_field_id, std::vector<ChessMove>& moves, const PiecePosition& king_pos) const;
+		/// <param name="allowed_fields">Bit-mask of the fields where the pawn can finish its move (see "MoveConstraints").</param>
+		void append_pawn_moves(const int pawn_field_id, MoveList& moves, const std::uint64_t allowed_fields) const;
 
 		/// <summary>
 		/// Append moves generated according ot the given
 		/// collection of attack directions and the start
 		/// position to the given collection of moves.
+		/// Only the moves finishing on the fields from the given bit-mask (see "MoveConstraints") are appended.
 		/// </summary>
-		void append_moves(const int start_field_id, std::vector<ChessMove>& moves,
-			const std::vector<AttackController::Direction>& attack_directions, const PiecePosition& king_pos) const;
-
-		/// <summary>
-		/// Validates the move defined with its start and finish positions and appends
-		/// it to the given collection of moves in case validation was successful.
-		///	Returns "true" if, disregarding whether the current move was successfully validated and appended to the given collection of moves,
-		///	it is possible in principle to continue moving in the same direction.
-		/// </summary>
-		bool validate_and_append_move(const PiecePosition& start_pos, const PiecePosition& finish_pos,
-			std::vector<ChessMove>& moves, const PiecePosition& king_pos) const;
+		void append_moves(const int start_field_id, MoveList& moves,
+			const std::vector<AttackController::Direction>& attack_directions, const std::uint64_t allowed_fields) const;
 
 		/// <summary>
 		/// Returns "true" if there is an "ally" piece on the field with the given ID.
@@ -286,13 +315,13 @@ namespace TrainingCell::Chess
 		/// <summary>
 		/// Returns collection of moves available in the current state.
 		/// </summary>
-		[[nodiscard]] std::vector<ChessMove> get_moves() const;
+		[[nodiscard]] MoveList get_moves() const;
 
 		/// <summary>
 		/// Fills the given collection with moves available in the current state.
 		/// Returns "true" if the current state is a "draw".
 		/// </summary>
-		virtual bool get_moves(std::vector<ChessMove>& out_result) const;
+		virtual bool get_moves(MoveList& out_result) const;
 
 		/// <summary>
 		/// Applies given "move" to the current board state.
@@ -316,6 +345,11 @@ namespace TrainingCell::Chess
 		template <bool D = false>
 		[[nodiscard]] std::vector<int> to_vector() const;
 
+		/// <summary>
+		/// Writes plain vector representation of the current state into the given container (which gets resized if needed).
+		/// </summary>
+		void to_vector(std::vector<int>& out_result) const;
+
 		/// <summary>
 		/// Returns size of the state represented as a vector of integers delivered by `to_vector()` method;
 		/// </summary>
@@ -326,6 +360,12 @@ namespace TrainingCell::Chess
 		/// </summary>
 		[[nodiscard]] std::vector<int> get_vector(const ChessMove& move) const;
 
+		/// <summary>
+		/// Writes plain vector representation of the current state after applying the given move to it
+		/// into the given container (which gets resized if needed).
+		/// </summary>
+		void get_vector(const ChessMove& move, std::vector<int>& out_result) const;
+
 		/// <summary>
 		/// Returns a plain vector representation of a state inverted to the current one.
 		/// </summary>
@@ -376,6 +416,11 @@ namespace TrainingCell::Chess
 		/// </summary>
 		[[nodiscard]] std::unique_ptr<IState> yield(const bool initialize_recorder) const override;
 
+		/// <summary>
+		/// See documentation of the base class.
+		/// </summary>
+		void yield(std::unique_ptr<IState>& state_ptr, const bool initialize_recorder) const override;
+
 		/// <summary>
 		/// Returns type identifier of the state.
 		/// </summary>
@@ -0,0 +1,302 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace TrainingCell
+{
+	template <class T>
+	class CoTask;
+
+	/// <summary>
+	/// Functionality of the promise of "CoTask" that does not depend on the type of the result.
+	/// </summary>
+	class CoTaskPromiseBase
+	{
+		/// <summary>
+		/// Coroutine to transfer control to when the task is over
+		/// (the one that awaits the task or "no-op" one for a top-level task).
+		/// </summary>
+		std::coroutine_handle<> _continuation{ std::noop_coroutine() };
+
+		/// <summary>
+		/// Exception thrown by the task (if any).
+		/// </summary>
+		std::exception_ptr _exception{};
+
+		/// <summary>
+		/// Awaiter that transfers control to the continuation when the task is over.
+		/// </summary>
+		struct FinalAwaiter
+		{
+			[[nodiscard]] bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			template <class P>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) const noexcept
+			{
+				return handle.promise()._continuation;
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+	public:
+		/// <summary>
+		/// Tasks are "lazy", i.e., they do not start until awaited (or resumed explicitly).
+		/// </summary>
+		[[nodiscard]] std::suspend_always initial_suspend() const noexcept
+		{
+			return {};
+		}
+
+		/// <summary>
+		/// See "FinalAwaiter".
+		/// </summary>
+		[[nodiscard]] FinalAwaiter final_suspend() const noexcept
+		{
+			return {};
+		}
+
+		/// <summary>
+		/// Stores the exception to be re-thrown to the awaiter of the task.
+		/// </summary>
+		void unhandled_exception() noexcept
+		{
+			_exception = std::current_exception();
+		}
+
+		/// <summary>
+		/// Sets the coroutine to transfer control to when the task is over.
+		/// </summary>
+		void set_continuation(const std::coroutine_handle<> continuation) noexcept
+		{
+			_continuation = continuation;
+		}
+
+		/// <summary>
+		/// Re-throws the exception thrown by the task (if any).
+		/// </summary>
+		void rethrow_if_exception() const
+		{
+			if (_exception)
+				std::rethrow_exception(_exception);
+		}
+	};
+
+	/// <summary>
+	/// Promise of "CoTask" with a result.
+	/// </summary>
+	template <class T>
+	class CoTaskPromise : public CoTaskPromiseBase
+	{
+		/// <summary>
+		/// Result of the task.
+		/// </summary>
+		std::optional<T> _value{};
+
+	public:
+		/// <summary>
+		/// Returns the task object associated with the promise.
+		/// </summary>
+		CoTask<T> get_return_object() noexcept;
+
+		/// <summary>
+		/// Stores the result of the task.
+		/// </summary>
+		void return_value(T value)
+		{
+			_value = std::move(value);
+		}
+
+		/// <summary>
+		/// Returns the result of the task (or re-throws the exception thrown by the task).
+		/// </summary>
+		T take_value()
+		{
+			rethrow_if_exception();
+			return std::move(*_value);
+		}
+	};
+
+	/// <summary>
+	/// Promise of "CoTask" without a result.
+	/// </summary>
+	template <>
+	class CoTaskPromise<void> : public CoTaskPromiseBase
+	{
+	public:
+		/// <summary>
+		/// Returns the task object associated with the promise.
+		/// </summary>
+		CoTask<void> get_return_object() noexcept;
+
+		/// <summary>
+		/// Completes the task.
+		/// </summary>
+		void return_void() const noexcept {}
+
+		/// <summary>
+		/// Re-throws the exception thrown by the task (if any).
+		/// </summary>
+		void take_value() const
+		{
+			rethrow_if_exception();
+		}
+	};
+
+	/// <summary>
+	/// A "lazy" C++20 coroutine that can be awaited by another coroutine (which gets resumed via symmetric transfer
+	/// when the task is over) or driven explicitly via "resume" (as a "top-level" task, see "EvaluationScheduler").
+	/// Exceptions thrown inside the task are propagated to its awaiter.
+	/// </summary>
+	template <class T = void>
+	class [[nodiscard]] CoTask
+	{
+	public:
+		/// <summary>
+		/// Promise type (required by the coroutine machinery).
+		/// </summary>
+		using promise_type = CoTaskPromise<T>;
+
+	private:
+		/// <summary>
+		/// Handle of the coroutine.
+		/// </summary>
+		std::coroutine_handle<promise_type> _handle{};
+
+		/// <summary>
+		/// Destroys the coroutine (if any).
+		/// </summary>
+		void destroy() noexcept
+		{
+			if (_handle)
+				std::exchange(_handle, {}).destroy();
+		}
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		explicit CoTask(const std::coroutine_handle<promise_type> handle) noexcept : _handle(handle)
+		{}
+
+		/// <summary>
+		/// Copy constructor - deleted.
+		/// </summary>
+		CoTask(const CoTask&) = delete;
+
+		/// <summary>
+		/// Copy assignment - deleted.
+		/// </summary>
+		CoTask& operator =(const CoTask&) = delete;
+
+		/// <summary>
+		/// Move constructor.
+		/// </summary>
+		CoTask(CoTask&& another_task) noexcept : _handle(std::exchange(another_task._handle, {}))
+		{}
+
+		/// <summary>
+		/// Move assignment.
+		/// </summary>
+		CoTask& operator =(CoTask&& another_task) noexcept
+		{
+			if (this != &another_task)
+			{
+				destroy();
+				_handle = std::exchange(another_task._handle, {});
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		/// Destructor.
+		/// </summary>
+		~CoTask()
+		{
+			destroy();
+		}
+
+		/// <summary>
+		/// Returns "true" if the task is over.
+		/// </summary>
+		[[nodiscard]] bool done() const noexcept
+		{
+			return !_handle || _handle.done();
+		}
+
+		/// <summary>
+		/// Starts (or resumes) execution of a "top-level" task; the control returns to the caller
+		/// as soon as the task (or any task it awaits) gets suspended.
+		/// </summary>
+		void resume() const
+		{
+			_handle.resume();
+		}
+
+		/// <summary>
+		/// Returns result of the task that is over (or re-throws the exception thrown by the task).
+		/// </summary>
+		T get()
+		{
+			return _handle.promise().take_value();
+		}
+
+		/// <summary>
+		/// The task is always started on awaiting.
+		/// </summary>
+		[[nodiscard]] bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		/// <summary>
+		/// Starts the task via symmetric transfer; the awaiting coroutine will be resumed when the task is over.
+		/// </summary>
+		std::coroutine_handle<> await_suspend(const std::coroutine_handle<> continuation) const noexcept
+		{
+			_handle.promise().set_continuation(continuation);
+			return _handle;
+		}
+
+		/// <summary>
+		/// Returns result of the task to the awaiting coroutine.
+		/// </summary>
+		T await_resume()
+		{
+			return get();
+		}
+	};
+
+	template <class T>
+	CoTask<T> CoTaskPromise<T>::get_return_object() noexcept
+	{
+		return CoTask<T>(std::coroutine_handle<CoTaskPromise>::from_promise(*this));
+	}
+
+	inline CoTask<void> CoTaskPromise<void>::get_return_object() noexcept
+	{
+		return CoTask<void>(std::coroutine_handle<CoTaskPromise>::from_promise(*this));
+	}
+}
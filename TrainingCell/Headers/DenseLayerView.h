@@ -0,0 +1,69 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "../../DeepLearning/DeepLearning/NeuralNet/Net.h"
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Read-only view of a fully connected layer of a neural net.
+	/// Provides "raw" access to the weights and biases of the layer
+	/// for the evaluation routines implemented on the side of the "training cell".
+	/// </summary>
+	struct DenseLayerView
+	{
+		/// <summary>
+		/// Pointer to the weight matrix of the layer (row-major, "out_size" rows by "in_size" columns).
+		/// </summary>
+		const DeepLearning::Real* weights{};
+
+		/// <summary>
+		/// Pointer to the biases of the layer ("out_size" elements).
+		/// </summary>
+		const DeepLearning::Real* biases{};
+
+		/// <summary>
+		/// Number of input neurons.
+		/// </summary>
+		int in_size{};
+
+		/// <summary>
+		/// Number of output neurons.
+		/// </summary>
+		int out_size{};
+
+		/// <summary>
+		/// Activation function of the layer.
+		/// </summary>
+		DeepLearning::ActivationFunctionId func_id{};
+
+		/// <summary>
+		/// Applies activation function of the layer to the given collection of values (in place).
+		/// </summary>
+		void activate(DeepLearning::Real* values, const int count) const;
+
+		/// <summary>
+		/// Fills the given collection with views of the layers of the given net.
+		/// Throws exception if the net contains layers other than fully connected ones
+		/// or layers with activation functions that are not supported.
+		/// The views remain valid until the net is either modified or destroyed.
+		/// </summary>
+		static void extract(const DeepLearning::Net<DeepLearning::CpuDC>& net, std::vector<DenseLayerView>& out_layers);
+	};
+}
@@ -0,0 +1,113 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "INet.h"
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// A thread-local pool of eligibility trace containers that can be shared by (sub-)agents
+	/// whose neural nets have the same topology (e.g., by the short-living training adapters used in TD-search),
+	/// so that the containers are not re-allocated for each new agent.
+	/// The pool of a thread lives as long as the thread (worker threads of the concurrency runtime live as long as the process),
+	/// so it keeps at most "MaxFreeCount" containers of at most "MaxFreeSize" bytes in total.
+	/// "clear()" can return the memory of the pool of the current thread to the heap, pools of other threads are not reachable.
+	/// </summary>
+	class EligibilityTracePool
+	{
+		/// <summary>
+		/// "Free" containers.
+		/// </summary>
+		std::vector<std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>> _free_traces{};
+
+		/// <summary>
+		/// Total size (in bytes) of the "free" containers.
+		/// </summary>
+		std::size_t _free_size{};
+
+		/// <summary>
+		/// The pool of the current thread.
+		/// </summary>
+		thread_local static EligibilityTracePool _thread_pool;
+
+		/// <summary>
+		/// Set when the pool of the current thread gets destroyed. Thread-local objects
+		/// are destroyed before the objects with static storage duration, so an agent
+		/// with static storage duration releases its traces after the pool is gone.
+		/// </summary>
+		thread_local static bool _thread_pool_destroyed;
+
+		/// <summary>
+		/// Returns size (in bytes) of the values stored in the given container.
+		/// </summary>
+		static std::size_t calc_size(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces);
+
+		/// <summary>
+		/// Fills the given container with zeros.
+		/// </summary>
+		static void fill_zero(std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces);
+
+	public:
+
+		/// <summary>
+		/// Maximal number of "free" containers kept by the pool of a thread
+		/// (enough for the two sub-agents of a short-living training adapter).
+		/// </summary>
+		static constexpr std::size_t MaxFreeCount = 2;
+
+		/// <summary>
+		/// Maximal total size (in bytes) of the "free" containers kept by the pool of a thread.
+		/// </summary>
+		static constexpr std::size_t MaxFreeSize = 1ull << 24;
+
+		/// <summary>
+		/// Destructor.
+		/// </summary>
+		~EligibilityTracePool();
+
+		/// <summary>
+		/// Assigns the given container with a one compatible with the given net and filled with zeros. The container is taken
+		/// from the pool of the current thread if possible (in which case "false" is returned), otherwise it gets allocated
+		/// by the net (in which case "true" is returned). Containers taken from the pool are zeroed explicitly rather than
+		/// "scaled by zero", so that NaN or infinite values left by the previous owner do not get to the new one.
+		/// </summary>
+		static bool acquire(const INet& net, std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& out_traces);
+
+		/// <summary>
+		/// Moves the given container (if not empty) to the pool of the current thread. The container is
+		/// just freed if it does not fit into "MaxFreeCount" and "MaxFreeSize" or if the pool of the thread is already destroyed
+		/// (which is the case when the method is called from destructors of objects with static storage duration).
+		/// </summary>
+		static void release(std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces);
+
+		/// <summary>
+		/// Frees all the "free" containers of the pool of the current thread.
+		/// </summary>
+		static void clear();
+
+		/// <summary>
+		/// Returns number of "free" containers in the pool of the current thread.
+		/// </summary>
+		static std::size_t get_free_count();
+
+		/// <summary>
+		/// Returns total size (in bytes) of the "free" containers in the pool of the current thread.
+		/// </summary>
+		static std::size_t get_free_size();
+	};
+}
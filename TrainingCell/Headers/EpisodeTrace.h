@@ -0,0 +1,161 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#pragma once
+#include "IStateReadOnly.h"
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Record of an episode: "int-vector" representations of the states in which moves were taken together with
+	/// the corresponding afterstates. The record can be "replayed" to agents as a sequence of states each offering
+	/// a single move (the one that was taken), so that agents can be trained on the episode without re-simulating it.
+	/// Containers are reused across episodes, so that in a "steady state" recording does not allocate.
+	/// </summary>
+	class EpisodeTrace : public IStateReadOnly
+	{
+		/// <summary>
+		/// States in which the moves were taken.
+		/// </summary>
+		std::vector<std::vector<int>> _states{};
+
+		/// <summary>
+		/// Afterstates of the taken moves.
+		/// </summary>
+		std::vector<std::vector<int>> _after_states{};
+
+		/// <summary>
+		/// Flags indicating whether the corresponding taken moves were "capture" ones.
+		/// </summary>
+		std::vector<bool> _capture_flags{};
+
+		/// <summary>
+		/// Flags indicating whether the corresponding states were "inverted".
+		/// </summary>
+		std::vector<bool> _inverted_flags{};
+
+		/// <summary>
+		/// Number of recorded plies.
+		/// </summary>
+		int _plies_count{};
+
+		/// <summary>
+		/// Index of the ply that is currently exposed through the state interface.
+		/// </summary>
+		int _current_ply_id{};
+
+		/// <summary>
+		/// State of the episode that was recorded (used to calculate rewards).
+		/// </summary>
+		const IMinimalStateReadonly* _origin_ptr{};
+
+		/// <summary>
+		/// Throws exception if the given move ID is invalid.
+		/// </summary>
+		static void validate_move_id(const int move_id);
+
+	public:
+		/// <summary>
+		/// Prepares the record to accommodate a new episode played on the given state
+		/// (which must outlive all the subsequent calls of "calc_reward").
+		/// </summary>
+		void reset(const IMinimalStateReadonly& origin);
+
+		/// <summary>
+		/// Records the move with the given ID taken in the given state.
+		/// </summary>
+		void add_ply(const IStateReadOnly& state, const int move_id);
+
+		/// <summary>
+		/// Returns number of recorded plies.
+		/// </summary>
+		[[nodiscard]] int get_plies_count() const;
+
+		/// <summary>
+		/// Exposes the ply with the given index through the state interface.
+		/// </summary>
+		void set_current_ply(const int ply_id);
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// The only available move is the one that was taken.
+		/// </summary>
+		[[nodiscard]] int get_moves_count() const override;
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// </summary>
+		[[nodiscard]] std::vector<int> evaluate(const int move_id) const override;
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// </summary>
+		void evaluate(const int move_id, std::vector<int>& out_afterstate) const override;
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// </summary>
+		[[nodiscard]] std::vector<int> evaluate() const override;
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// </summary>
+		void evaluate(std::vector<int>& out_state) const override;
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// </summary>
+		[[nodiscard]] double calc_reward(const std::vector<int>& prev_state,
+			const std::vector<int>& next_state) const override;
+
+		/// <summary>
+		/// Not supported (the seeds of the recorded states are not available),
+		/// so that agents relying on it (e.g., those doing TD-search) can't be trained on the record.
+		/// </summary>
+		[[nodiscard]] const IStateSeed& current_state_seed() const override;
+
+		/// <summary>
+		/// Not supported.
+		/// </summary>
+		[[nodiscard]] const std::vector<Move> get_all_moves() const override;
+
+		/// <summary>
+		/// Not supported.
+		/// </summary>
+		[[nodiscard]] std::vector<int> evaluate_ui() const override;
+
+		/// <summary>
+		/// Not supported.
+		/// </summary>
+		[[nodiscard]] std::vector<int> evaluate_ui_inverted() const override;
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// </summary>
+		[[nodiscard]] bool is_capture_action(const int action_id) const override;
+
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// </summary>
+		[[nodiscard]] bool is_inverted() const override;
+
+		/// <summary>
+		/// See summary of the base class declaration (a state in which a move was taken is never a draw).
+		/// </summary>
+		[[nodiscard]] bool is_draw() const override;
+	};
+}
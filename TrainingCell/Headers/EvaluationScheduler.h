@@ -0,0 +1,169 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#pragma once
+#include "CoTask.h"
+#include "INet.h"
+#include "BatchNetEvaluator.h"
+#include "IMinimalStateReadonly.h"
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Batched inference back end for games expressed as coroutines ("CoTask"): a game "co_awaits" values of all
+	/// the afterstates of its current state (see "evaluate_afterstates"), the scheduler accumulates such requests
+	/// from all the suspended games and, when none of the games can proceed, evaluates them in large batches
+	/// (a batch per net) after which resumes the games in the order in which the requests were made.
+	/// All the games are run in the calling thread.
+	/// </summary>
+	class EvaluationScheduler
+	{
+		/// <summary>
+		/// Request to evaluate afterstates of a state.
+		/// </summary>
+		struct Request
+		{
+			/// <summary>
+			/// Net to evaluate the afterstates with.
+			/// </summary>
+			const INet* net_ptr{};
+
+			/// <summary>
+			/// State whose afterstates should be evaluated.
+			/// </summary>
+			const IMinimalStateReadonly* state_ptr{};
+
+			/// <summary>
+			/// Container to receive the values.
+			/// </summary>
+			std::vector<double>* out_values_ptr{};
+
+			/// <summary>
+			/// Coroutine to resume when the values are available.
+			/// </summary>
+			std::coroutine_handle<> handle{};
+		};
+
+		/// <summary>
+		/// Requests that are waiting to be evaluated.
+		/// </summary>
+		std::vector<Request> _pending{};
+
+		/// <summary>
+		/// Requests that are being evaluated.
+		/// </summary>
+		std::vector<Request> _in_flight{};
+
+		/// <summary>
+		/// "Top-level" tasks (games) to run.
+		/// </summary>
+		std::vector<CoTask<void>> _tasks{};
+
+		/// <summary>
+		/// Evaluator of the batches of afterstates.
+		/// </summary>
+		BatchNetEvaluator _evaluator{};
+
+		/// <summary>
+		/// States of the current batch.
+		/// </summary>
+		std::vector<const IMinimalStateReadonly*> _batch_states{};
+
+		/// <summary>
+		/// Indices (in the collection of "in-flight" requests) of the requests of the current batch.
+		/// </summary>
+		std::vector<int> _batch_request_ids{};
+
+		/// <summary>
+		/// Maximal number of afterstates in a batch (unless a single state has more afterstates).
+		/// </summary>
+		const int _max_batch_size{};
+
+		/// <summary>
+		/// Evaluates all the "in-flight" requests and then resumes the corresponding coroutines.
+		/// </summary>
+		void flush();
+
+		/// <summary>
+		/// Evaluates the current batch with the given net, distributes the values among the requests and clears the batch.
+		/// </summary>
+		void evaluate_batch(const INet& net);
+
+	public:
+		/// <summary>
+		/// Awaiter of the values of afterstates.
+		/// </summary>
+		class AfterstateValuesAwaiter
+		{
+			/// <summary>
+			/// Scheduler to submit the request to.
+			/// </summary>
+			EvaluationScheduler& _scheduler;
+
+			/// <summary>
+			/// The request.
+			/// </summary>
+			Request _request;
+
+		public:
+			/// <summary>
+			/// Constructor.
+			/// </summary>
+			AfterstateValuesAwaiter(EvaluationScheduler& scheduler, const Request& request);
+
+			/// <summary>
+			/// The values are never available immediately.
+			/// </summary>
+			[[nodiscard]] bool await_ready() const noexcept;
+
+			/// <summary>
+			/// Submits the request to the scheduler.
+			/// </summary>
+			void await_suspend(const std::coroutine_handle<> handle);
+
+			/// <summary>
+			/// The values are delivered to the container provided with the request.
+			/// </summary>
+			void await_resume() const noexcept;
+		};
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="max_batch_size">Maximal number of afterstates to evaluate in a single batch.</param>
+		explicit EvaluationScheduler(const int max_batch_size = 4096);
+
+		/// <summary>
+		/// Returns an awaitable request to evaluate all the afterstates of the given state with the given net;
+		/// the values get assigned to the given container (the i-th value corresponds to the move with ID = i)
+		/// and might differ from those returned by the "single state" evaluation within the round-off error.
+		/// The state, the net and the container must stay alive until the awaiting coroutine is resumed.
+		/// </summary>
+		[[nodiscard]] AfterstateValuesAwaiter evaluate_afterstates(const INet& net, const IMinimalStateReadonly& state,
+			std::vector<double>& out_values);
+
+		/// <summary>
+		/// Adds the given "top-level" task to be run by the next call of the "run" method.
+		/// </summary>
+		void spawn(CoTask<void>&& task);
+
+		/// <summary>
+		/// Runs all the spawned tasks until they are over; re-throws the first exception thrown by the tasks (if any).
+		/// </summary>
+		void run();
+	};
+}
@@ -0,0 +1,355 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "NetWithConverterAbstract.h"
+#include "DenseLayerView.h"
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <utility>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Fully connected layer with dimensions and activation function known at compile time.
+	/// </summary>
+	template <int InSize, int OutSize, DeepLearning::ActivationFunctionId FuncId>
+	struct FixedLayer
+	{
+		static_assert(InSize > 0 && OutSize > 0, "Invalid layer dimensions.");
+		static_assert(FuncId == DeepLearning::ActivationFunctionId::RELU ||
+			FuncId == DeepLearning::ActivationFunctionId::LINEAR, "Unsupported activation function.");
+
+		static constexpr int in_size = InSize;
+		static constexpr int out_size = OutSize;
+
+		/// <summary>
+		/// Weight matrix (row-major, "OutSize" rows by "InSize" columns).
+		/// </summary>
+		alignas(64) std::array<DeepLearning::Real, InSize * OutSize> weights{};
+
+		/// <summary>
+		/// Biases.
+		/// </summary>
+		alignas(64) std::array<DeepLearning::Real, OutSize> biases{};
+
+		/// <summary>
+		/// Copies weights and biases from the given view.
+		/// Throws exception if dimensions or activation function of the view are different.
+		/// </summary>
+		void assign(const DenseLayerView& view)
+		{
+			if (view.in_size != InSize || view.out_size != OutSize || view.func_id != FuncId)
+				throw std::exception("The net is incompatible with the fixed topology.");
+
+			std::copy(view.weights, view.weights + weights.size(), weights.begin());
+			std::copy(view.biases, view.biases + biases.size(), biases.begin());
+		}
+
+		/// <summary>
+		/// Calculates output of the layer ("OutSize" elements) for the given input ("InSize" elements).
+		/// </summary>
+		void act(const DeepLearning::Real* in, DeepLearning::Real* out) const
+		{
+			for (auto row_id = 0; row_id < OutSize; ++row_id)
+			{
+				const auto row = weights.data() + row_id * InSize;
+				auto sum = biases[row_id];
+
+				for (auto col_id = 0; col_id < InSize; ++col_id)
+					sum += row[col_id] * in[col_id];
+
+				if constexpr (FuncId == DeepLearning::ActivationFunctionId::RELU)
+					sum = std::max(sum, static_cast<DeepLearning::Real>(0));
+
+				out[row_id] = sum;
+			}
+		}
+	};
+
+	namespace Details
+	{
+		/// <summary>
+		/// Returns "true" if output dimension of each layer in the given tuple is equal to the input dimension of the next layer.
+		/// </summary>
+		template <class LayersTuple, std::size_t... LayerIds>
+		constexpr bool layer_dimensions_match(std::index_sequence<LayerIds...>)
+		{
+			return ((std::tuple_element_t<LayerIds, LayersTuple>::out_size ==
+				std::tuple_element_t<LayerIds + 1, LayersTuple>::in_size) && ...);
+		}
+	}
+
+	/// <summary>
+	/// Neural net with state converter, in which evaluation is done by a copy of the net
+	/// with the topology (dimensions and activation functions of the layers) fixed at compile time,
+	/// so that the compiler can fully unroll and vectorize the (small) layers.
+	/// Training-related functionality (gradient calculation, updates) is delegated to the "regular" net,
+	/// and the fixed copy is synchronized after each update.
+	/// The values it returns are equal to those of the "regular" net up to round-off errors.
+	/// </summary>
+	template <class... Layers>
+	class FixedTopologyNet : public NetWithConverterAbstract
+	{
+		static_assert(sizeof...(Layers) > 0, "At least one layer is expected.");
+
+		using LayersTuple = std::tuple<Layers...>;
+		static constexpr std::size_t LayersCount = sizeof...(Layers);
+		static constexpr int InSize = std::tuple_element_t<0, LayersTuple>::in_size;
+
+		static_assert(std::tuple_element_t<LayersCount - 1, LayersTuple>::out_size == 1,
+			"Net with a single output neuron is expected.");
+		static_assert(Details::layer_dimensions_match<LayersTuple>(std::make_index_sequence<LayersCount - 1>{}),
+			"Dimensions of the consecutive layers do not match.");
+
+		StateConverter _converter;
+		DeepLearning::Net<DeepLearning::CpuDC> _net;
+		LayersTuple _layers{};
+
+		/// <summary>
+		/// Does the forward pass starting from the layer with the given index.
+		/// </summary>
+		template <std::size_t LayerId>
+		[[nodiscard]] DeepLearning::Real forward(const DeepLearning::Real* in) const
+		{
+			using Layer = std::tuple_element_t<LayerId, LayersTuple>;
+			alignas(64) std::array<DeepLearning::Real, Layer::out_size> out;
+			std::get<LayerId>(_layers).act(in, out.data());
+
+			if constexpr (LayerId + 1 == LayersCount)
+				return out[0];
+			else
+				return forward<LayerId + 1>(out.data());
+		}
+
+		/// <summary>
+		/// Copies weights and biases from the "regular" net to the fixed one.
+		/// </summary>
+		void synchronize()
+		{
+			std::vector<DenseLayerView> views;
+			DenseLayerView::extract(_net, views);
+
+			if (views.size() != LayersCount)
+				throw std::exception("The net is incompatible with the fixed topology.");
+
+			[&]<std::size_t... LayerIds>(std::index_sequence<LayerIds...>)
+			{
+				(std::get<LayerIds>(_layers).assign(views[LayerIds]), ...);
+			}(std::make_index_sequence<LayersCount>{});
+		}
+
+		/// <summary>
+		/// Buffer to store converted states.
+		/// </summary>
+		thread_local static inline std::array<DeepLearning::Real, InSize> _input_shared{};
+
+		/// <summary>
+		/// Buffer to store states in their "standard" representation.
+		/// </summary>
+		thread_local static inline std::vector<int> _state_vector_shared{};
+
+	protected:
+		/// <summary>
+		/// See summary in the base class.
+		/// Modifications of the net done through the returned reference are not
+		/// reflected in the fixed copy (except those done via "update" method).
+		/// </summary>
+		DeepLearning::Net<DeepLearning::CpuDC>& net() override
+		{
+			return _net;
+		}
+
+		/// <summary>
+		/// See summary in the base class.
+		/// </summary>
+		const DeepLearning::Net<DeepLearning::CpuDC>& net() const override
+		{
+			return _net;
+		}
+
+		/// <summary>
+		/// See summary in the base class.
+		/// </summary>
+		const StateConverter& converter() const override
+		{
+			return _converter;
+		}
+
+	public:
+		/// <summary>
+		/// Constructor. Throws exception if the topology of the given net differs from the fixed one.
+		/// </summary>
+		FixedTopologyNet(const DeepLearning::Net<DeepLearning::CpuDC>& net, StateConverter converter) :
+			_converter(std::move(converter)), _net(net)
+		{
+			synchronize();
+		}
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		double evaluate(const std::vector<int>& state, DeepLearning::CpuDC::tensor_t& out_state_converted,
+			DeepLearning::Net<DeepLearning::CpuDC>::Context& comp_context) const override
+		{
+			convert(state, out_state_converted);
+
+			if (out_state_converted.size() != static_cast<std::size_t>(InSize))
+				throw std::exception("The net is incompatible with the state.");
+
+			return forward<0>(out_state_converted.begin());
+		}
+
+		/// <summary>
+		/// See summary of the base class (the values are accessible through the evaluator,
+		/// its other data are not used).
+		/// </summary>
+		void evaluate_afterstates(const IMinimalStateReadonly& state, BatchNetEvaluator& evaluator) const override
+		{
+			auto& values = evaluator.values();
+			values.resize(state.get_moves_count());
+
+			for (auto move_id = 0; move_id < static_cast<int>(values.size()); ++move_id)
+			{
+				state.evaluate(move_id, _state_vector_shared);
+
+				if (static_cast<long long>(_state_vector_shared.size()) * _converter.get_expansion_factor() != InSize)
+					throw std::exception("The net is incompatible with the state.");
+
+				_converter.convert(_state_vector_shared, _input_shared.data());
+				values[move_id] = forward<0>(_input_shared.data());
+			}
+		}
+
+		/// <summary>
+		/// See summary of the base class (the values are accessible through the evaluator,
+		/// its other data are not used).
+		/// </summary>
+		void evaluate_afterstates(const std::vector<const IMinimalStateReadonly*>& states, BatchNetEvaluator& evaluator) const override
+		{
+			auto& values = evaluator.values();
+			values.clear();
+
+			for (const auto state_ptr : states)
+			{
+				const auto moves_count = state_ptr->get_moves_count();
+
+				for (auto move_id = 0; move_id < moves_count; ++move_id)
+				{
+					state_ptr->evaluate(move_id, _state_vector_shared);
+
+					if (static_cast<long long>(_state_vector_shared.size()) * _converter.get_expansion_factor() != InSize)
+						throw std::exception("The net is incompatible with the state.");
+
+					_converter.convert(_state_vector_shared, _input_shared.data());
+					values.push_back(forward<0>(_input_shared.data()));
+				}
+			}
+		}
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void update(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient,
+			const double learning_rate, const double& lambda) override
+		{
+			NetWithConverterAbstract::update(gradient, learning_rate, lambda);
+			synchronize();
+		}
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		double td_zero_update(const DeepLearning::CpuDC::tensor_t& state, const double target_value,
+			const double learning_rate) override
+		{
+			const auto result = NetWithConverterAbstract::td_zero_update(state, target_value, learning_rate);
+			synchronize();
+			return result;
+		}
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		double td_lambda_update(const DeepLearning::CpuDC::tensor_t& state, const double target_value,
+			const double learning_rate, const double trace_decay,
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces) override
+		{
+			// in the "non-sparse" mode the base implementation calls "update" which synchronizes the fixed copy itself
+			const auto result = NetWithConverterAbstract::td_lambda_update(state, target_value, learning_rate, trace_decay, traces);
+
+			if (get_sparse_input())
+				synchronize();
+
+			return result;
+		}
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void td_lambda_return_update(const std::vector<DeepLearning::CpuDC::tensor_t>& after_states,
+			const std::vector<double>& rewards, const int count, const double learning_rate,
+			const double discount, const double lambda) override
+		{
+			NetWithConverterAbstract::td_lambda_return_update(after_states, rewards, count, learning_rate, discount, lambda);
+			synchronize();
+		}
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void batch_update(const std::vector<DeepLearning::Real>& after_states, const std::vector<double>& targets,
+			const int count, const double learning_rate, std::vector<double>& out_values) override
+		{
+			NetWithConverterAbstract::batch_update(after_states, targets, count, learning_rate, out_values);
+			synchronize();
+		}
+	};
+
+	namespace Details
+	{
+		/// <summary>
+		/// Builds "standard" fixed-topology net type (RELU hidden layers and LINEAR output layer)
+		/// from the given dimensions of the layers.
+		/// </summary>
+		template <class LayersList, int... Dims>
+		struct StandardFixedTopology;
+
+		template <class... Layers, int InSize, int OutSize>
+		struct StandardFixedTopology<std::tuple<Layers...>, InSize, OutSize>
+		{
+			using type = FixedTopologyNet<Layers..., FixedLayer<InSize, OutSize, DeepLearning::ActivationFunctionId::LINEAR>>;
+		};
+
+		template <class... Layers, int InSize, int OutSize, int NextSize, int... Rest>
+		struct StandardFixedTopology<std::tuple<Layers...>, InSize, OutSize, NextSize, Rest...>
+		{
+			using type = typename StandardFixedTopology<std::tuple<Layers...,
+				FixedLayer<InSize, OutSize, DeepLearning::ActivationFunctionId::RELU>>, OutSize, NextSize, Rest...>::type;
+		};
+	}
+
+	/// <summary>
+	/// Fixed-topology net with the given dimensions of the layers (including the input and the output ones),
+	/// RELU activation of the hidden layers and LINEAR activation of the output layer,
+	/// i.e., the topology of nets of TD-lambda agents ("NetDim"). For example,
+	/// "StandardFixedTopologyNet&lt;32, 32, 16, 8, 1&gt;" corresponds to a checkers agent with hidden layers {32, 16, 8}.
+	/// </summary>
+	template <int... Dims>
+	using StandardFixedTopologyNet = typename Details::StandardFixedTopology<std::tuple<>, Dims...>::type;
+}
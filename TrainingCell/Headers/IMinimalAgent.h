@@ -17,9 +17,12 @@
 
 #pragma once
 #include "IStateReadOnly.h"
+#include "CoTask.h"
 
 namespace TrainingCell
 {
+	class EvaluationScheduler;
+
 	/// <summary>
 	///	Representation of possible game statuses
 	/// </summary>
@@ -46,6 +49,16 @@ namespace TrainingCell
 		/// </summary>
 		virtual int make_move(const IStateReadOnly& state, const bool as_white) = 0;
 
+		/// <summary>
+		/// Coroutine version of "make_move" that allows the agent to "co_await" evaluation requests submitted
+		/// to the given scheduler (so that requests of many concurrently played games can be evaluated in batches).
+		/// The default implementation falls back to the regular "make_move".
+		/// </summary>
+		virtual CoTask<int> make_move_async(const IStateReadOnly& state, const bool as_white, EvaluationScheduler& scheduler)
+		{
+			co_return make_move(state, as_white);
+		}
+
 		/// <summary>
 		/// The method is supposed to be called by the "training environment" when the current training episode is over
 		/// to notify the agent about the "final" state and the result of entire game (episode)
@@ -44,11 +44,23 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] virtual std::vector<int> evaluate(const int move_id) const = 0;
 
+		/// <summary>
+		/// The same as above, but the result is written into the given container (which gets resized if needed),
+		/// so that no allocations take place provided that the container has enough capacity.
+		/// </summary>
+		virtual void evaluate(const int move_id, std::vector<int>& out_afterstate) const = 0;
+
 		/// <summary>
 		/// Returns "int-vector" representation of the current state (without any move "applied").
 		/// </summary>
 		[[nodiscard]] virtual std::vector<int> evaluate() const = 0;
 
+		/// <summary>
+		/// The same as above, but the result is written into the given container (which gets resized if needed),
+		/// so that no allocations take place provided that the container has enough capacity.
+		/// </summary>
+		virtual void evaluate(std::vector<int>& out_state) const = 0;
+
 		/// <summary>
 		/// For the given pair of previous and next states represented with "int-vectors",
 		/// calculates reward "suggested" by the difference between the states.
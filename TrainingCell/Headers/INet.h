@@ -17,6 +17,10 @@
 
 #pragma once
 #include "../../DeepLearning/DeepLearning/NeuralNet/Net.h"
+#include "BatchNetEvaluator.h"
+#include "AfterstateValueCache.h"
+#include "ReplayBuffer.h"
+#include "IMinimalStateReadonly.h"
 
 namespace TrainingCell
 {
@@ -46,12 +50,74 @@ namespace TrainingCell
 		virtual double evaluate(const std::vector<int>& state, DeepLearning::CpuDC::tensor_t& out_state_converted,
 			DeepLearning::Net<DeepLearning::CpuDC>::Context& comp_context) const = 0;
 
+		/// <summary>
+		/// Converts given state into its tensor representation (the one that is "consumed" by the neural net).
+		/// </summary>
+		virtual void convert(const std::vector<int>& state, DeepLearning::CpuDC::tensor_t& out_state_converted) const = 0;
+
+		/// <summary>
+		/// Evaluates all the afterstates of the given state in a single (batched) pass through the neural net
+		/// The values are accessible through the given evaluator (the i-th value corresponds to the afterstate of the move with ID = i)
+		/// and might differ from those returned by the "single state" evaluation method within the round-off error.
+		/// </summary>
+		virtual void evaluate_afterstates(const IMinimalStateReadonly& state,
+			BatchNetEvaluator& evaluator) const = 0;
+
+		/// <summary>
+		/// Evaluates all the afterstates of all the given states in a single (batched) pass through the neural net.
+		/// The values are accessible through the given evaluator and are arranged state after state
+		/// (within each state in the order of move IDs). The "incremental" first layer mode of the evaluator
+		/// is not supported (since the afterstates do not share a common "base" state).
+		/// </summary>
+		virtual void evaluate_afterstates(const std::vector<const IMinimalStateReadonly*>& states,
+			BatchNetEvaluator& evaluator) const = 0;
+
 		/// <summary>
 		/// Updates weights of the neural net according to the given gradient, learning rate and regularization parameters.
 		/// </summary>
 		virtual void update(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient,
 			const double learning_rate, const double& lambda) = 0;
 
+		/// <summary>
+		/// Does TD(0) update of the weights of the neural net at the given (converted) state, i.e., adds
+		/// "learning_rate * (target_value - value) * gradient" to the weights, where "value" and "gradient" are
+		/// the value of the net at the state and its gradient (with respect to the weights).
+		/// Returns the value of the net at the state (before the update).
+		/// </summary>
+		virtual double td_zero_update(const DeepLearning::CpuDC::tensor_t& state, const double target_value,
+			const double learning_rate) = 0;
+
+		/// <summary>
+		/// Does TD(lambda) update of the weights of the neural net at the given (converted) state:
+		/// scales the given eligibility traces with the given decay factor, adds the gradient of the net at the state to them
+		/// and then adds "learning_rate * (target_value - value) * traces" to the weights,
+		/// where "value" is the value of the net at the state (which is returned).
+		/// </summary>
+		virtual double td_lambda_update(const DeepLearning::CpuDC::tensor_t& state, const double target_value,
+			const double learning_rate, const double trace_decay,
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces) = 0;
+
+		/// <summary>
+		/// Does a single "offline" lambda-return update of the weights of the neural net over an episode, i.e., adds
+		/// "learning_rate * (return_i - value_i) * gradient_i" summed over the given number of first (converted) afterstates
+		/// of the episode, where "value_i" and "gradient_i" are the value of the net at the i-th afterstate and its gradient,
+		/// while "return_i" is the lambda-return of the afterstate calculated with the current weights of the net and
+		/// the given rewards (the i-th reward is the one received after the i-th afterstate, the last afterstate is followed
+		/// by the terminal state).
+		/// </summary>
+		virtual void td_lambda_return_update(const std::vector<DeepLearning::CpuDC::tensor_t>& after_states,
+			const std::vector<double>& rewards, const int count, const double learning_rate,
+			const double discount, const double lambda) = 0;
+
+		/// <summary>
+		/// Does a single mini-batched update of the weights of the neural net, i.e., adds
+		/// "learning_rate * (targets[i] - value_i) * gradient_i" summed over the given number of (converted) afterstates
+		/// (stored as rows of the given row-major matrix) to the weights, where "value_i" and "gradient_i" are the value
+		/// of the net at the i-th afterstate and its gradient. The values (before the update) are returned via the output parameter.
+		/// </summary>
+		virtual void batch_update(const std::vector<DeepLearning::Real>& after_states, const std::vector<double>& targets,
+			const int count, const double learning_rate, std::vector<double>& out_values) = 0;
+
 		/// <summary>
 		/// Returns "true" if the net is "compatible" with a state of the given size.
 		/// </summary>
@@ -61,5 +127,23 @@ namespace TrainingCell
 		/// Method to allocate gradient container.
 		/// </summary>
 		virtual void allocate(std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient, const bool assign_zero) const = 0;
+
+		/// <summary>
+		/// Returns "true" if the given gradient container can be used with the net
+		/// (i.e., if it was allocated by the net or by another net of the same topology).
+		/// </summary>
+		[[nodiscard]] virtual bool is_compatible(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient) const = 0;
+
+		/// <summary>
+		/// Returns pointer to the cache of afterstate values that can be used at the moment
+		/// or "nullptr" if there is no such cache (in particular, if the net can get modified).
+		/// </summary>
+		[[nodiscard]] virtual AfterstateValueCache* value_cache() const = 0;
+
+		/// <summary>
+		/// Returns pointer to the buffer that training samples should be added to (in order to be replayed later)
+		/// or "nullptr" if experience replay is not used at the moment.
+		/// </summary>
+		[[nodiscard]] virtual ReplayBuffer* replay_buffer() = 0;
 	};
 }
@@ -40,6 +40,12 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] virtual std::unique_ptr<IState> yield(const bool initialize_recorder) const = 0;
 
+		/// <summary>
+		/// Re-initializes the given instance of "IState" if it was previously yielded by a seed of the same type
+		/// (so that the memory allocated by the instance gets reused), otherwise assigns it with a newly yielded instance.
+		/// </summary>
+		virtual void yield(std::unique_ptr<IState>& state_ptr, const bool initialize_recorder) const = 0;
+
 		/// <summary>
 		/// Returns type identifier of the state that can be yielded by the "seed".
 		/// </summary>
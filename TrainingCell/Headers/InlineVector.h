@@ -0,0 +1,340 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include <vector>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <cstddef>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Vector-like container that keeps up to "Capacity" items in an inline buffer,
+	/// so that it does not touch the heap as long as the number of items does not exceed the capacity.
+	/// Should the capacity get exceeded, all the items are transferred to a heap "overflow" buffer
+	/// (which is retained after clearing and is used again only when the capacity gets exceeded again).
+	/// The items are always stored contiguously.
+	/// </summary>
+	template <class T, std::size_t Capacity>
+	class InlineVector
+	{
+		/// <summary>
+		/// Inline buffer (only the first "_size" items are "alive" when the container is not overflown).
+		/// </summary>
+		alignas(T) std::byte _storage[sizeof(T) * Capacity];
+
+		/// <summary>
+		/// Buffer that holds all the items when their number exceeds the capacity of the inline buffer.
+		/// </summary>
+		std::vector<T> _overflow_items{};
+
+		/// <summary>
+		/// Number of items.
+		/// </summary>
+		std::size_t _size{};
+
+		/// <summary>
+		/// Returns "true" if the items are stored in the "overflow" buffer.
+		/// </summary>
+		[[nodiscard]] bool is_overflown() const
+		{
+			return _size > Capacity;
+		}
+
+		/// <summary>
+		/// Pointer to the first item of the inline buffer.
+		/// </summary>
+		T* inline_data()
+		{
+			return std::launder(reinterpret_cast<T*>(_storage));
+		}
+
+		/// <summary>
+		/// Pointer to the first item of the inline buffer.
+		/// </summary>
+		const T* inline_data() const
+		{
+			return std::launder(reinterpret_cast<const T*>(_storage));
+		}
+
+		/// <summary>
+		/// Moves the items from the inline buffer to the "overflow" one.
+		/// </summary>
+		void overflow()
+		{
+			_overflow_items.reserve(2 * Capacity);
+			std::move(inline_data(), inline_data() + _size, std::back_inserter(_overflow_items));
+			std::destroy_n(inline_data(), _size);
+		}
+
+		/// <summary>
+		/// Takes over the items of the given container leaving it empty.
+		/// </summary>
+		void take_over(InlineVector& source)
+		{
+			if (source.is_overflown())
+				_overflow_items = std::move(source._overflow_items);
+			else
+				std::uninitialized_move(source.inline_data(), source.inline_data() + source._size, inline_data());
+
+			_size = source._size;
+			source.clear();
+		}
+
+	public:
+
+		using value_type = T;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		InlineVector() {}
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		template <class It>
+		InlineVector(It first, It last)
+		{
+			append(first, last);
+		}
+
+		/// <summary>
+		/// Copy constructor.
+		/// </summary>
+		InlineVector(const InlineVector& source)
+		{
+			append(source.begin(), source.end());
+		}
+
+		/// <summary>
+		/// Move constructor.
+		/// </summary>
+		InlineVector(InlineVector&& source) noexcept
+		{
+			take_over(source);
+		}
+
+		/// <summary>
+		/// Copy assignment operator.
+		/// </summary>
+		InlineVector& operator =(const InlineVector& source)
+		{
+			if (this != &source)
+				assign(source.begin(), source.end());
+
+			return *this;
+		}
+
+		/// <summary>
+		/// Move assignment operator.
+		/// </summary>
+		InlineVector& operator =(InlineVector&& source) noexcept
+		{
+			if (this != &source)
+			{
+				clear();
+				take_over(source);
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		/// Destructor.
+		/// </summary>
+		~InlineVector()
+		{
+			clear();
+		}
+
+		/// <summary>
+		/// Capacity of the inline buffer.
+		/// </summary>
+		static constexpr std::size_t inline_capacity()
+		{
+			return Capacity;
+		}
+
+		/// <summary>
+		/// Number of items.
+		/// </summary>
+		[[nodiscard]] std::size_t size() const
+		{
+			return _size;
+		}
+
+		/// <summary>
+		/// Returns "true" if the container is empty.
+		/// </summary>
+		[[nodiscard]] bool empty() const
+		{
+			return _size == 0;
+		}
+
+		/// <summary>
+		/// Pointer to the first item.
+		/// </summary>
+		[[nodiscard]] T* data()
+		{
+			return is_overflown() ? _overflow_items.data() : inline_data();
+		}
+
+		/// <summary>
+		/// Pointer to the first item.
+		/// </summary>
+		[[nodiscard]] const T* data() const
+		{
+			return is_overflown() ? _overflow_items.data() : inline_data();
+		}
+
+		/// <summary>
+		/// Iterator pointing to the first item.
+		/// </summary>
+		iterator begin()
+		{
+			return data();
+		}
+
+		/// <summary>
+		/// Iterator pointing to the "past the last" item.
+		/// </summary>
+		iterator end()
+		{
+			return data() + _size;
+		}
+
+		/// <summary>
+		/// Iterator pointing to the first item.
+		/// </summary>
+		const_iterator begin() const
+		{
+			return data();
+		}
+
+		/// <summary>
+		/// Iterator pointing to the "past the last" item.
+		/// </summary>
+		const_iterator end() const
+		{
+			return data() + _size;
+		}
+
+		/// <summary>
+		/// Access to the item with the given index.
+		/// </summary>
+		T& operator [](const std::size_t id)
+		{
+			return data()[id];
+		}
+
+		/// <summary>
+		/// Access to the item with the given index.
+		/// </summary>
+		const T& operator [](const std::size_t id) const
+		{
+			return data()[id];
+		}
+
+		/// <summary>
+		/// Access to the last item.
+		/// </summary>
+		T& back()
+		{
+			return data()[_size - 1];
+		}
+
+		/// <summary>
+		/// Access to the last item.
+		/// </summary>
+		const T& back() const
+		{
+			return data()[_size - 1];
+		}
+
+		/// <summary>
+		/// Removes all the items (the inline buffer becomes the "active" one again).
+		/// </summary>
+		void clear()
+		{
+			if (is_overflown())
+				_overflow_items.clear();
+			else
+				std::destroy_n(inline_data(), _size);
+
+			_size = 0;
+		}
+
+		/// <summary>
+		/// Appends the given item.
+		/// </summary>
+		template <class I>
+		void push_back(I&& item)
+		{
+			if (_size < Capacity)
+			{
+				std::construct_at(inline_data() + _size, std::forward<I>(item));
+				++_size;
+				return;
+			}
+
+			if (_size == Capacity)
+			{
+				// "item" can refer to one of the inline items that are about to be destroyed
+				T item_copy(std::forward<I>(item));
+				overflow();
+				_overflow_items.push_back(std::move(item_copy));
+			}
+			else
+				_overflow_items.push_back(std::forward<I>(item));
+
+			++_size;
+		}
+
+		/// <summary>
+		/// Appends the items from the given range.
+		/// </summary>
+		template <class It>
+		void append(It first, It last)
+		{
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		/// <summary>
+		/// Replaces the content of the container with the items from the given range.
+		/// </summary>
+		template <class It>
+		void assign(It first, It last)
+		{
+			clear();
+			append(first, last);
+		}
+
+		/// <summary>
+		/// Returns "true" if the given containers have the same items.
+		/// </summary>
+		bool operator ==(const InlineVector& another) const
+		{
+			return std::equal(begin(), end(), another.begin(), another.end());
+		}
+	};
+}
@@ -16,12 +16,12 @@
 //SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
-#include "../../DeepLearning/DeepLearning/NeuralNet/DataContext.h"
 
 namespace TrainingCell
 {
 	/// <summary>
 	/// Holds data related to a picked move
+	/// (the afterstate itself is not stored and is supposed to be calculated on demand, if needed)
 	/// </summary>
 	struct MoveData
 	{
@@ -35,11 +35,6 @@ namespace TrainingCell
 		/// </summary>
 		double value{};
 
-		/// <summary>
-		/// After-sate resulted from the move (in a form of tensor, see 'State::to_tensor()')
-		/// </summary>
-		DeepLearning::CpuDC::tensor_t after_state{};
-
 		/// <summary>
 		/// Equality operator.
 		/// </summary>
@@ -18,6 +18,8 @@
 #pragma once
 #include "INet.h"
 #include "StateConverter.h"
+#include "SparseInputNet.h"
+#include "BatchNetTrainer.h"
 
 namespace TrainingCell
 {
@@ -26,6 +28,36 @@ namespace TrainingCell
 	/// </summary>
 	class NetWithConverterAbstract : public INet
 	{
+		/// <summary>
+		/// Defines whether the "sparse input" evaluation mode is on (see "SparseInputNet").
+		/// </summary>
+		bool _sparse_input{};
+
+		/// <summary>
+		/// Shared resource to use in the "sparse input" evaluation mode.
+		/// </summary>
+		thread_local static SparseInputNet _sparse_net;
+
+		/// <summary>
+		/// Shared computation context.
+		/// </summary>
+		thread_local static DeepLearning::Net<DeepLearning::CpuDC>::Context _context;
+
+		/// <summary>
+		/// Shared tensor to store value of the net.
+		/// </summary>
+		thread_local static DeepLearning::CpuDC::tensor_t _value_shared;
+
+		/// <summary>
+		/// Shared resource to do mini-batched updates.
+		/// </summary>
+		thread_local static BatchNetTrainer _batch_trainer;
+
+		/// <summary>
+		/// Gradient container used by the TD(0) update in the "dense" mode.
+		/// </summary>
+		thread_local static std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> _gradient_shared;
+
 	protected:
 		/// <summary>
 		/// Access to the net.
@@ -57,12 +89,60 @@ namespace TrainingCell
 		double evaluate(const std::vector<int>& state, DeepLearning::CpuDC::tensor_t& out_state_converted,
 			DeepLearning::Net<DeepLearning::CpuDC>::Context& comp_context) const override;
 
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void convert(const std::vector<int>& state, DeepLearning::CpuDC::tensor_t& out_state_converted) const override;
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void evaluate_afterstates(const IMinimalStateReadonly& state,
+			BatchNetEvaluator& evaluator) const override;
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void evaluate_afterstates(const std::vector<const IMinimalStateReadonly*>& states,
+			BatchNetEvaluator& evaluator) const override;
+
 		/// <summary>
 		/// See summary of the base class.
 		/// </summary>
 		void update(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient,
 			const double learning_rate, const double& lambda) override;
 
+		/// <summary>
+		/// See summary of the base class. In the "sparse input" mode the update is done in a single back-propagation pass
+		/// which touches only the first-layer weights that correspond to non-zero elements of the state;
+		/// otherwise it is done in the same way as the TD(lambda) update with zero trace decay (and without a persistent trace).
+		/// </summary>
+		double td_zero_update(const DeepLearning::CpuDC::tensor_t& state, const double target_value,
+			const double learning_rate) override;
+
+		/// <summary>
+		/// See summary of the base class. In the "sparse input" mode back-propagation,
+		/// update of the traces and update of the weights are fused into a single sweep for each layer;
+		/// otherwise the gradient is calculated and applied by the net in separate passes.
+		/// </summary>
+		double td_lambda_update(const DeepLearning::CpuDC::tensor_t& state, const double target_value,
+			const double learning_rate, const double trace_decay,
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces) override;
+
+		/// <summary>
+		/// See summary of the base class. All the afterstates are propagated through the net
+		/// as a single mini-batch (see "BatchNetTrainer").
+		/// </summary>
+		void td_lambda_return_update(const std::vector<DeepLearning::CpuDC::tensor_t>& after_states,
+			const std::vector<double>& rewards, const int count, const double learning_rate,
+			const double discount, const double lambda) override;
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void batch_update(const std::vector<DeepLearning::Real>& after_states, const std::vector<double>& targets,
+			const int count, const double learning_rate, std::vector<double>& out_values) override;
+
 		/// <summary>
 		/// See summary of the base class.
 		/// </summary>
@@ -73,10 +153,40 @@ namespace TrainingCell
 		/// </summary>
 		static std::size_t calc_input_net_size(const std::size_t state_size, const StateConverter& converter);
 
+		/// <summary>
+		/// Turns on/off the "sparse input" evaluation mode in which the first layer of the net
+		/// is evaluated (and differentiated) touching only the weights that correspond to non-zero
+		/// elements of the input (which is beneficial for the chess nets where most of the input is zero).
+		/// In this mode the results are equal to those of the regular mode up to round-off errors.
+		/// Only nets consisting of fully connected layers are supported.
+		/// </summary>
+		void set_sparse_input(const bool sparse_input);
+
+		/// <summary>
+		/// Returns "true" if the "sparse input" evaluation mode is on.
+		/// </summary>
+		[[nodiscard]] bool get_sparse_input() const;
+
 		/// <summary>
 		/// See summary of the base class.
 		/// </summary>
 		void allocate(std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient, const bool assign_zero) const override;
+
+		/// <summary>
+		/// See summary of the base class (only fully connected layers are recognized,
+		/// so that "false" is returned for the nets containing layers of other types).
+		/// </summary>
+		[[nodiscard]] bool is_compatible(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient) const override;
+
+		/// <summary>
+		/// See summary of the base class (there is no value cache by default).
+		/// </summary>
+		[[nodiscard]] AfterstateValueCache* value_cache() const override;
+
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		[[nodiscard]] ReplayBuffer* replay_buffer() override;
 	};
 
 }
@@ -0,0 +1,134 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "DenseLayerView.h"
+#include "StateConverter.h"
+#include "IMinimalStateReadonly.h"
+#include "MoveData.h"
+#include <cstdint>
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Read-only "inference snapshot" of a fully connected neural net (together with its state converter),
+	/// in which the weights are quantized to 8-bit integers (with a separate scale factor for each output neuron),
+	/// the intermediate activations are quantized to 16-bit integers and the dot-products are accumulated in 32-bit integers.
+	/// The values it returns approximate those of the original net and are supposed to be used
+	/// only for playing (i.e., when the weights of the net are not updated).
+	/// The snapshot is independent of the original net and has to be re-created when the latter gets modified.
+	/// </summary>
+	class QuantizedNet
+	{
+		/// <summary>
+		/// Quantized representation of a fully connected layer.
+		/// </summary>
+		struct Layer
+		{
+			/// <summary>
+			/// Quantized weights (row-major, "out_size" rows by "in_size" columns).
+			/// </summary>
+			std::vector<std::int8_t> weights{};
+
+			/// <summary>
+			/// Scale factors of the rows of the weight matrix
+			/// (the original weight is approximately equal to the quantized one times the scale factor of the row).
+			/// </summary>
+			std::vector<DeepLearning::Real> row_scales{};
+
+			/// <summary>
+			/// Biases of the layer (not quantized).
+			/// </summary>
+			std::vector<DeepLearning::Real> biases{};
+
+			/// <summary>
+			/// Maximal absolute value of a quantized input element which guarantees
+			/// that the 32-bit accumulators of the layer do not overflow.
+			/// </summary>
+			int input_limit{};
+
+			/// <summary>
+			/// Number of input neurons.
+			/// </summary>
+			int in_size{};
+
+			/// <summary>
+			/// Number of output neurons.
+			/// </summary>
+			int out_size{};
+
+			/// <summary>
+			/// Activation function of the layer.
+			/// </summary>
+			DeepLearning::ActivationFunctionId func_id{};
+		};
+
+		/// <summary>
+		/// Quantized layers of the net.
+		/// </summary>
+		std::vector<Layer> _layers{};
+
+		/// <summary>
+		/// State converter.
+		/// </summary>
+		StateConverter _converter{};
+
+		/// <summary>
+		/// Buffers to store input and output of a layer during the evaluation.
+		/// </summary>
+		thread_local static std::vector<DeepLearning::Real> _buffers[2];
+
+		/// <summary>
+		/// Buffer to store quantized input of a layer during the evaluation.
+		/// </summary>
+		thread_local static std::vector<std::int16_t> _input_quantized;
+
+		/// <summary>
+		/// Buffer to store "standard" representation of a state.
+		/// </summary>
+		thread_local static std::vector<int> _state_vector;
+
+		/// <summary>
+		/// Returns value of the net on the input that is stored in the first buffer.
+		/// </summary>
+		[[nodiscard]] double evaluate_buffer() const;
+
+	public:
+		/// <summary>
+		/// Default constructor.
+		/// </summary>
+		QuantizedNet() = default;
+
+		/// <summary>
+		/// Constructs quantized snapshot of the given net and converter.
+		/// Throws exception if the net contains layers other than fully connected ones
+		/// or layers with activation functions that are not supported.
+		/// </summary>
+		QuantizedNet(const DeepLearning::Net<DeepLearning::CpuDC>& net, const StateConverter& converter);
+
+		/// <summary>
+		/// Returns value of the net at the given state (in its "standard" representation).
+		/// </summary>
+		[[nodiscard]] double evaluate(const std::vector<int>& state) const;
+
+		/// <summary>
+		/// Returns ID and value of the afterstate of the given state that has the highest value.
+		/// </summary>
+		[[nodiscard]] MoveData pick_move(const IMinimalStateReadonly& state) const;
+	};
+}
@@ -0,0 +1,209 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include <vector>
+#include "../../DeepLearning/DeepLearning/NeuralNet/Net.h"
+#include "../../DeepLearning/DeepLearning/RandomGenerator.h"
+
+namespace TrainingCell
+{
+	class INet;
+
+	/// <summary>
+	/// Bounded buffer of training samples (converted afterstates together with their TD-targets)
+	/// that allows to reuse past experience in mini-batched updates of a neural net.
+	/// The samples are stored as a "structure of arrays": afterstates occupy rows of a single contiguous matrix,
+	/// targets are stored in a separate array. When the buffer is full, the oldest samples get overwritten.
+	/// Mini-batches are sampled either uniformly or proportionally to the magnitude of the TD-errors of the samples
+	/// (the "prioritized" mode, in which the errors are refreshed each time the samples are replayed).
+	/// Copies of the buffer are empty (the samples are tied to the particular training process).
+	/// </summary>
+	class ReplayBuffer
+	{
+		/// <summary>
+		/// Maximal number of samples in the buffer (zero means that the buffer is disabled).
+		/// </summary>
+		int _capacity{};
+
+		/// <summary>
+		/// Number of samples in a mini-batch.
+		/// </summary>
+		int _batch_size{};
+
+		/// <summary>
+		/// Number of samples to be added to the buffer between two consecutive replays.
+		/// </summary>
+		int _replay_interval{};
+
+		/// <summary>
+		/// Defines whether the samples are drawn proportionally to the magnitude of their TD-errors (otherwise uniformly).
+		/// </summary>
+		bool _prioritized{};
+
+		/// <summary>
+		/// Size of a single afterstate.
+		/// </summary>
+		int _item_size{};
+
+		/// <summary>
+		/// Number of samples in the buffer.
+		/// </summary>
+		int _size{};
+
+		/// <summary>
+		/// ID of the slot to put the next sample to.
+		/// </summary>
+		int _next_id{};
+
+		/// <summary>
+		/// Number of samples added since the last replay.
+		/// </summary>
+		int _added_since_replay{};
+
+		/// <summary>
+		/// Afterstates (row-major, one row per sample).
+		/// </summary>
+		std::vector<DeepLearning::Real> _after_states{};
+
+		/// <summary>
+		/// TD-targets of the afterstates.
+		/// </summary>
+		std::vector<double> _targets{};
+
+		/// <summary>
+		/// Binary "sum tree" of priorities used in the "prioritized" mode (the root is at index 1,
+		/// leaves start at index "_leaves_offset" and each inner node holds the sum of its children).
+		/// </summary>
+		std::vector<double> _priorities{};
+
+		/// <summary>
+		/// Index of the first leaf in the tree of priorities.
+		/// </summary>
+		std::size_t _leaves_offset{};
+
+		/// <summary>
+		/// Random generator used to draw samples.
+		/// </summary>
+		DeepLearning::RandomGenerator _generator{};
+
+		/// <summary>
+		/// IDs of the samples of the current mini-batch.
+		/// </summary>
+		std::vector<int> _batch_ids{};
+
+		/// <summary>
+		/// Afterstates of the current mini-batch (row-major).
+		/// </summary>
+		std::vector<DeepLearning::Real> _batch_after_states{};
+
+		/// <summary>
+		/// Targets of the current mini-batch.
+		/// </summary>
+		std::vector<double> _batch_targets{};
+
+		/// <summary>
+		/// Values of the current mini-batch.
+		/// </summary>
+		std::vector<double> _batch_values{};
+
+		/// <summary>
+		/// Constant added to magnitudes of the TD-errors, so that each sample has a chance to be replayed.
+		/// </summary>
+		static constexpr double PriorityOffset = 1e-3;
+
+		/// <summary>
+		/// Assigns priority of the sample with the given ID according to the given value and target.
+		/// </summary>
+		void update_priority(const int sample_id, const double value, const double target);
+
+		/// <summary>
+		/// Returns ID of a randomly drawn sample.
+		/// </summary>
+		[[nodiscard]] int draw_sample_id();
+
+		/// <summary>
+		/// Does a mini-batched update of the given net on the samples drawn from the buffer.
+		/// </summary>
+		void replay(INet& net, const double learning_rate);
+
+	public:
+		/// <summary>
+		/// Default constructor (the buffer is disabled).
+		/// </summary>
+		ReplayBuffer() = default;
+
+		/// <summary>
+		/// Constructs an empty buffer.
+		/// </summary>
+		/// <param name="capacity">Maximal number of samples in the buffer (zero disables the buffer).</param>
+		/// <param name="batch_size">Number of samples in a mini-batch.</param>
+		/// <param name="replay_interval">Number of samples to be added between two consecutive replays.</param>
+		/// <param name="prioritized">If "true" samples are drawn proportionally to the magnitude of their TD-errors.</param>
+		ReplayBuffer(const int capacity, const int batch_size, const int replay_interval, const bool prioritized);
+
+		/// <summary>
+		/// Copy constructor (constructs an empty buffer with the same configuration).
+		/// </summary>
+		ReplayBuffer(const ReplayBuffer& another_buffer);
+
+		/// <summary>
+		/// Copy assignment (the current buffer becomes empty with the same configuration as the given one).
+		/// </summary>
+		ReplayBuffer& operator =(const ReplayBuffer& another_buffer);
+
+		/// <summary>
+		/// Move constructor.
+		/// </summary>
+		ReplayBuffer(ReplayBuffer&& another_buffer) noexcept = default;
+
+		/// <summary>
+		/// Move assignment.
+		/// </summary>
+		ReplayBuffer& operator =(ReplayBuffer&& another_buffer) noexcept = default;
+
+		/// <summary>
+		/// Returns "true" if the buffer has the given configuration.
+		/// </summary>
+		[[nodiscard]] bool has_configuration(const int capacity, const int batch_size,
+			const int replay_interval, const bool prioritized) const;
+
+		/// <summary>
+		/// Returns "true" if the buffer has non-zero capacity.
+		/// </summary>
+		[[nodiscard]] bool is_enabled() const;
+
+		/// <summary>
+		/// Returns number of samples in the buffer.
+		/// </summary>
+		[[nodiscard]] int get_size() const;
+
+		/// <summary>
+		/// Adds the given sample to the buffer and, if it is time to do so, does a mini-batched update
+		/// of the given net on the samples drawn from the buffer: adds "learning_rate * sum_i (target_i - value_i) * gradient_i"
+		/// to the weights of the net, where "value_i" and "gradient_i" are the (current) value of the net at the i-th
+		/// drawn afterstate and its gradient, while "target_i" is the TD-target stored together with the afterstate.
+		/// </summary>
+		void add(const DeepLearning::CpuDC::tensor_t& after_state, const double value, const double target,
+			INet& net, const double learning_rate);
+
+		/// <summary>
+		/// Removes all the samples from the buffer.
+		/// </summary>
+		void clear();
+	};
+}
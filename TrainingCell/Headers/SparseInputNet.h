@@ -0,0 +1,109 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "DenseLayerView.h"
+#include "StateConverter.h"
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Evaluation and gradient calculation routines for fully connected nets with sparse input.
+	/// Only the columns of the first layer weight matrix that correspond to non-zero input elements are touched.
+	/// </summary>
+	class SparseInputNet
+	{
+		/// <summary>
+		/// Views of the layers of the net.
+		/// </summary>
+		std::vector<DenseLayerView> _layers{};
+
+		/// <summary>
+		/// Pre-activations of the layers calculated during the last forward pass.
+		/// </summary>
+		std::vector<std::vector<DeepLearning::Real>> _pre_activations{};
+
+		/// <summary>
+		/// Outputs (activations) of the layers calculated during the last forward pass.
+		/// </summary>
+		std::vector<std::vector<DeepLearning::Real>> _activations{};
+
+		/// <summary>
+		/// Auxiliary buffers for the back-propagation pass (used in turns).
+		/// </summary>
+		std::vector<DeepLearning::Real> _deltas[2]{};
+
+		/// <summary>
+		/// Sparse representation of the input.
+		/// </summary>
+		SparseState _input{};
+
+		/// <summary>
+		/// Does the forward pass on the current input and returns value of the net.
+		/// </summary>
+		double forward();
+
+	public:
+		/// <summary>
+		/// Returns reference to the sparse input to be filled by the caller before calling "evaluate"
+		/// or "calc_gradient_and_value" methods.
+		/// </summary>
+		SparseState& input();
+
+		/// <summary>
+		/// Fills the sparse input from the given dense one.
+		/// </summary>
+		void assign_input(const DeepLearning::CpuDC::tensor_t& dense_input);
+
+		/// <summary>
+		/// Returns value of the given net on the current input.
+		/// </summary>
+		double evaluate(const DeepLearning::Net<DeepLearning::CpuDC>& net);
+
+		/// <summary>
+		/// Returns value of the given net on the current input and adds gradient of the value
+		/// (with respect to the parameters of the net) to the given gradient container
+		/// which is preliminary scaled with the given factor. The container must be allocated beforehand.
+		/// </summary>
+		double calc_gradient_and_value(const DeepLearning::Net<DeepLearning::CpuDC>& net,
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& out_gradient, const DeepLearning::Real scale);
+
+		/// <summary>
+		/// Does TD(0) update of the given net on the current input, i.e., adds
+		/// "learning_rate * (target_value - value) * gradient" to the parameters of the net, where "value" and "gradient"
+		/// are the value of the net on the current input and its gradient (with respect to the parameters).
+		/// The gradient is never materialized: the parameters of each layer are updated during the back-propagation pass
+		/// right after they were used to calculate derivatives with respect to the input of the layer.
+		/// Returns the value of the net (before the update).
+		/// </summary>
+		double td_zero_update(DeepLearning::Net<DeepLearning::CpuDC>& net,
+			const DeepLearning::Real target_value, const DeepLearning::Real learning_rate);
+
+		/// <summary>
+		/// Does TD(lambda) update of the given net on the current input, i.e., scales the given eligibility traces
+		/// with the given decay factor, adds the gradient of the value of the net on the current input to them
+		/// and then adds "learning_rate * (target_value - value) * traces" to the parameters of the net.
+		/// For each layer, back-propagation, update of the traces and update of the parameters are done in a single sweep
+		/// (the parameters are updated right after they were used to calculate derivatives with respect to the input of the layer).
+		/// The traces must be allocated beforehand. Returns the value of the net (before the update).
+		/// </summary>
+		double td_lambda_update(DeepLearning::Net<DeepLearning::CpuDC>& net,
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces, const DeepLearning::Real target_value,
+			const DeepLearning::Real learning_rate, const DeepLearning::Real trace_decay);
+	};
+}
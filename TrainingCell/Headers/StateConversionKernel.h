@@ -0,0 +1,160 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "StateConverter.h"
+#include "Chess/PieceController.h"
+#include <array>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Compile-time specialized state conversion routines.
+	/// </summary>
+	template <StateConversionType T>
+	struct StateConversionKernel;
+
+	/// <summary>
+	/// Conversion of checkers states (values of the input elements are copied "as is").
+	/// </summary>
+	template <>
+	struct StateConversionKernel<StateConversionType::CheckersStandard>
+	{
+		/// <summary>
+		/// Ratio between the output and input data dimensions.
+		/// </summary>
+		static constexpr int ExpansionFactor = 1;
+
+		/// <summary>
+		/// Converts the given input and writes the result to the given memory.
+		/// </summary>
+		static void convert(const std::vector<int>& in, DeepLearning::Real* out)
+		{
+			for (auto item_id = 0ull; item_id < in.size(); ++item_id)
+				out[item_id] = static_cast<DeepLearning::Real>(in[item_id]);
+		}
+
+		/// <summary>
+		/// Converts the given input into a sparse representation.
+		/// </summary>
+		static void convert(const std::vector<int>& in, SparseState& out)
+		{
+			out.clear();
+
+			for (auto item_id = 0; item_id < static_cast<int>(in.size()); ++item_id)
+			{
+				if (in[item_id] == 0)
+					continue;
+
+				out.ids.push_back(item_id);
+				out.values.push_back(static_cast<DeepLearning::Real>(in[item_id]));
+			}
+		}
+	};
+
+	/// <summary>
+	/// Conversion of chess states (each piece token is expanded into "rank bits count" channels
+	/// holding bits of the piece rank with the sign that depends on whether the piece is an "ally" or a "rival" one).
+	/// </summary>
+	template <>
+	struct StateConversionKernel<StateConversionType::ChessStandard>
+	{
+		/// <summary>
+		/// Ratio between the output and input data dimensions.
+		/// </summary>
+		static constexpr int ExpansionFactor = Chess::PieceController::RankBitsCount;
+
+	private:
+		/// <summary>
+		/// Number of different "keys" of the expansion table (rank bits plus the "rival" bit).
+		/// </summary>
+		static constexpr int KeysCount = 1 << (ExpansionFactor + 1);
+
+		/// <summary>
+		/// Returns key of the expansion table corresponding to the given token.
+		/// </summary>
+		static int to_key(const int piece_token)
+		{
+			return (piece_token & Chess::PieceController::MinBitMask) |
+				(Chess::PieceController::is_rival_piece(piece_token) ? (1 << ExpansionFactor) : 0);
+		}
+
+		/// <summary>
+		/// Builds table containing the "expanded" channels for each possible key.
+		/// </summary>
+		static constexpr std::array<std::array<DeepLearning::Real, ExpansionFactor>, KeysCount> build_table()
+		{
+			std::array<std::array<DeepLearning::Real, ExpansionFactor>, KeysCount> result{};
+
+			for (auto key = 0; key < KeysCount; ++key)
+			{
+				const auto sign = (key & (1 << ExpansionFactor)) != 0 ? -1 : 1;
+
+				for (auto channel_id = 0; channel_id < ExpansionFactor; ++channel_id)
+					result[key][channel_id] = static_cast<DeepLearning::Real>((key & (1 << channel_id)) != 0 ? sign : 0);
+			}
+
+			return result;
+		}
+
+		/// <summary>
+		/// Expansion table.
+		/// </summary>
+		static constexpr auto Table = build_table();
+
+	public:
+		/// <summary>
+		/// Converts the given input and writes the result to the given memory.
+		/// The channel bits are expanded through a lookup table, which keeps the loop branch-free
+		/// and lets the compiler vectorize it.
+		/// </summary>
+		static void convert(const std::vector<int>& in, DeepLearning::Real* out)
+		{
+			for (const auto piece_token : in)
+			{
+				const auto& channels = Table[to_key(piece_token)];
+
+				for (auto channel_id = 0; channel_id < ExpansionFactor; ++channel_id)
+					out[channel_id] = channels[channel_id];
+
+				out += ExpansionFactor;
+			}
+		}
+
+		/// <summary>
+		/// Converts the given input into a sparse representation.
+		/// </summary>
+		static void convert(const std::vector<int>& in, SparseState& out)
+		{
+			out.clear();
+
+			for (auto item_id = 0; item_id < static_cast<int>(in.size()); ++item_id)
+			{
+				const auto& channels = Table[to_key(in[item_id])];
+
+				for (auto channel_id = 0; channel_id < ExpansionFactor; ++channel_id)
+				{
+					if (channels[channel_id] == 0)
+						continue;
+
+					out.ids.push_back(item_id * ExpansionFactor + channel_id);
+					out.values.push_back(channels[channel_id]);
+				}
+			}
+		}
+	};
+}
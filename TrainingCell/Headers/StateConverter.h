@@ -17,7 +17,7 @@
 
 #pragma once
 #include "../../DeepLearning/DeepLearning/NeuralNet/DataContext.h"
-#include <functional>
+#include <vector>
 
 namespace TrainingCell
 {
@@ -31,6 +31,31 @@ namespace TrainingCell
 		ChessStandard = 2,
 	};
 
+	/// <summary>
+	/// Sparse representation of a converted state (only non-zero elements are stored).
+	/// </summary>
+	struct SparseState
+	{
+		/// <summary>
+		/// Indices of non-zero elements.
+		/// </summary>
+		std::vector<int> ids{};
+
+		/// <summary>
+		/// Values of non-zero elements.
+		/// </summary>
+		std::vector<DeepLearning::Real> values{};
+
+		/// <summary>
+		/// Removes all the elements (preserving the allocated memory).
+		/// </summary>
+		void clear()
+		{
+			ids.clear();
+			values.clear();
+		}
+	};
+
 	/// <summary>
 	/// Functionality to do custom conversion of "standard" state representations into
 	/// neural net "consumable" tensors.
@@ -44,8 +69,6 @@ namespace TrainingCell
 		/// </summary>
 		int _expansion_factor{ -1 };
 
-		std::function<void(const std::vector<int>&, DeepLearning::CpuDC::tensor_t&)> _operator;
-
 		/// <summary>
 		/// Activation method.
 		/// </summary>
@@ -87,6 +110,18 @@ namespace TrainingCell
 		/// </summary>
 		void convert(const std::vector<int>& in, DeepLearning::CpuDC::tensor_t& out) const;
 
+		/// <summary>
+		/// Converts input vector and writes the result to the memory pointed by the given pointer.
+		/// It is a responsibility of the caller to ensure that the memory can accommodate
+		/// "expansion factor" times the size of the input vector elements.
+		/// </summary>
+		void convert(const std::vector<int>& in, DeepLearning::Real* out) const;
+
+		/// <summary>
+		/// Converts input vector into a sparse representation (the dense result of conversion is never materialized).
+		/// </summary>
+		void convert(const std::vector<int>& in, SparseState& out) const;
+
 		/// <summary>
 		/// Equality operator.
 		/// </summary>
@@ -37,6 +37,11 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] std::unique_ptr<IState> yield(const bool initialize_recorder) const override;
 
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		void yield(std::unique_ptr<IState>& state_ptr, const bool initialize_recorder) const override;
+
 		/// <summary>
 		/// See summary of the base class.
 		/// </summary>
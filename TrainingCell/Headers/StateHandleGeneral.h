@@ -41,13 +41,18 @@ namespace TrainingCell
 		/// <summary>
 		/// Collection of "available" actions.
 		/// </summary>
-		std::vector<typename S::Move> _actions{};
+		typename S::MoveList _actions{};
 
 		/// <summary>
 		/// Pointer to a state trace recorder.
 		/// </summary>
 		std::unique_ptr<StateTraceRecorder<typename S::BaseState>> _trace_recorder_ptr{};
 
+		/// <summary>
+		/// Evaluates "available" actions of the current state and (if requested) initializes the recorder.
+		/// </summary>
+		void initialize(const bool initialize_recorder);
+
 	public:
 
 		/// <summary>
@@ -60,6 +65,12 @@ namespace TrainingCell
 		/// </summary>
 		StateHandleGeneral(S state, const bool initialize_recorder = false);
 
+		/// <summary>
+		/// Re-initializes the handle with the given state (the memory allocated for the
+		/// collection of actions and for the recorder is reused).
+		/// </summary>
+		void reset(const S& state, const bool initialize_recorder = false);
+
 		/// <summary>
 		/// See documentation of the base class.
 		/// </summary>
@@ -70,11 +81,21 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] std::vector<int> evaluate(const int move_id) const override;
 
+		/// <summary>
+		/// See documentation of the base class.
+		/// </summary>
+		void evaluate(const int move_id, std::vector<int>& out_afterstate) const override;
+
 		/// <summary>
 		/// See documentation of the base class.
 		/// </summary>
 		[[nodiscard]] std::vector<int> evaluate() const override;
 
+		/// <summary>
+		/// See documentation of the base class.
+		/// </summary>
+		void evaluate(std::vector<int>& out_state) const override;
+
 		/// <summary>
 		/// See documentation of the base class.
 		/// </summary>
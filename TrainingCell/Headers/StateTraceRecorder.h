@@ -41,6 +41,11 @@ namespace TrainingCell
 		/// </summary>
 		StateTraceRecorder(const S& init_state);
 
+		/// <summary>
+		/// Re-initializes the recorder with the given state (the memory allocated for the records is reused).
+		/// </summary>
+		void reset(const S& init_state);
+
 		/// <summary>
 		/// Appends move to the collection of "recorded" moves.
 		/// </summary>
@@ -58,7 +63,7 @@ namespace TrainingCell
 		/// <summary>
 		/// Fills the given array with all the possible moves "in the current state".
 		/// </summary>
-		bool get_moves(std::vector<typename S::Move>& out_result) const override;
+		bool get_moves(typename S::MoveList& out_result) const override;
 
 		/// <summary>
 		/// "Applies" the given move to the current state and inverts the state.
@@ -22,6 +22,8 @@
 #include "../../DeepLearning/DeepLearning/NeuralNet/Net.h"
 #include "../../DeepLearning/DeepLearning/RandomGenerator.h"
 #include "INet.h"
+#include "CoTask.h"
+#include "EvaluationScheduler.h"
 
 namespace TrainingCell
 {
@@ -68,7 +70,41 @@ namespace TrainingCell
 		bool _new_game{true};
 
 		/// <summary>
-		///	Auxiliary data structure that is used during training process
+		/// A flag indicating that eligibility traces are used in the current episode
+		/// (they are not needed when "lambda" parameter is zero, i.e., in TD(0) case)
+		/// </summary>
+		bool _use_traces{true};
+
+		/// <summary>
+		/// A flag indicating that the eligibility traces contain values left from the previous episode
+		/// (the traces are not zeroed in advance, instead the first update of the episode is done with zero trace decay)
+		/// </summary>
+		bool _reset_traces{false};
+
+		/// <summary>
+		/// A flag indicating that the current episode is trained in the "episode-batched" mode
+		/// (see "ITdlSettingsReadOnly::get_episode_batched_training")
+		/// </summary>
+		bool _episode_batched{false};
+
+		/// <summary>
+		/// Afterstates of the current episode buffered in the "episode-batched" mode
+		/// (the buffer is reused across episodes, so that only the first "_episode_length" items are relevant)
+		/// </summary>
+		std::vector<DeepLearning::CpuDC::tensor_t> _episode_after_states{};
+
+		/// <summary>
+		/// Rewards received after the corresponding buffered afterstates of the current episode
+		/// </summary>
+		std::vector<double> _episode_rewards{};
+
+		/// <summary>
+		/// Number of afterstates buffered in the current episode
+		/// </summary>
+		int _episode_length{};
+
+		/// <summary>
+		///	Eligibility traces (kept allocated across episodes and returned to "EligibilityTracePool" on destruction)
 		/// </summary>
 		std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> _z{};
 
@@ -82,11 +118,33 @@ namespace TrainingCell
 		/// </summary>
 		thread_local static DeepLearning::CpuDC::tensor_t _tensor_shared;
 
+		/// <summary>
+		/// Shared resource to hold "int-vector" representation of afterstates during the net evaluation
+		/// </summary>
+		thread_local static std::vector<int> _state_vector_shared;
+
+		/// <summary>
+		/// Shared resource to use during the batched evaluation of afterstates
+		/// </summary>
+		thread_local static BatchNetEvaluator _batch_evaluator;
+
+		/// <summary>
+		/// Relative tolerance used to decide whether two values calculated via batched evaluation
+		/// are too close to be compared reliably (taking into account the round-off discrepancy
+		/// between the batched and the regular evaluation)
+		/// </summary>
+		static constexpr double BatchComparisonTolerance = 1e-4;
+
 		/// <summary>
 		/// Previous state
 		/// </summary>
 		std::vector<int> _prev_state{};
 
+		/// <summary>
+		/// Current state (a container that is swapped with the "previous state" one to avoid allocations)
+		/// </summary>
+		std::vector<int> _current_state{};
+
 		/// <summary>
 		/// Previous afterstate
 		/// </summary>
@@ -97,6 +155,11 @@ namespace TrainingCell
 		/// </summary>
 		int _move_counter{ 0 };
 
+		/// <summary>
+		/// Values of afterstates delivered by an evaluation scheduler (see the coroutine version of "make_move")
+		/// </summary>
+		std::vector<double> _afterstate_values{};
+
 		/// <summary>
 		/// Returns index of the picked move and the related data
 		/// </summary>
@@ -105,11 +168,30 @@ namespace TrainingCell
 
 		/// <summary>
 		/// Calculates afterstate and its value.
+		/// The value is taken from the value cache of the net (if the latter is available and contains the value);
+		/// in this case the "afterstate" tensor is not assigned.
 		/// </summary>
 		[[nodiscard]] static double evaluate(const IMinimalStateReadonly& state, const int move_id,
 			const INet& net, DeepLearning::CpuDC::tensor_t& afterstate,
 			DeepLearning::Net<DeepLearning::CpuDC>::Context& comp_context);
 
+		/// <summary>
+		/// Evaluates all the afterstates of the given state in a batched manner and then re-evaluates in a regular way
+		/// those afterstates whose values are too close to values of some other afterstates to be reliably compared.
+		/// As a result, comparison of any pair of the returned values yields exactly the same result as if all the
+		/// values were calculated in the regular way.
+		/// If the net provides a value cache, all the values are calculated in the regular way (with the help of the cache).
+		/// </summary>
+		[[nodiscard]] static const std::vector<double>& evaluate_afterstates(const IMinimalStateReadonly& state, const INet& net);
+
+		/// <summary>
+		/// Refines the given values of all the afterstates of the given state (calculated via batched evaluation)
+		/// by re-evaluating in a regular way those of them that are too close to values of some other afterstates to be
+		/// reliably compared (see "evaluate_afterstates"). Returns reference to the refined values.
+		/// </summary>
+		static const std::vector<double>& refine_afterstate_values(const IMinimalStateReadonly& state, const INet& net,
+			std::vector<double>& values);
+
 		/// <summary>
 		/// Returns "true" if it is time to do an "exploration move".
 		/// The method is supposed to be called within the "pick_move" subroutine.
@@ -122,9 +204,38 @@ namespace TrainingCell
 		[[nodiscard]] static MoveData explore(const IMinimalStateReadonly& state, const INet& net, const int exploration_volume);
 
 		/// <summary>
-		/// Updates "z" field and returns value of the afterstate value function at the "previous afterstate"
+		/// Returns data of a move picked via exploration given the values of all the afterstates of the state.
+		/// </summary>
+		/// <param name="state">State to pick a move in.</param>
+		/// <param name="net">Net to evaluate the picked afterstate.</param>
+		/// <param name="exploration_volume">Number of the "best score" moves taking part in the exploration.</param>
+		/// <param name="picked_option_id">Index of the picked option among the "best score" moves.</param>
+		/// <param name="values">Values of all the afterstates of the state.</param>
+		[[nodiscard]] static MoveData explore(const IMinimalStateReadonly& state, const INet& net, const int exploration_volume,
+			const int picked_option_id, const std::vector<double>& values);
+
+		/// <summary>
+		/// Returns index of the "best score" move given the values of all the afterstates of the state (and the related data).
+		/// </summary>
+		[[nodiscard]] static MoveData pick_move(const IMinimalStateReadonly& state, const INet& net, const std::vector<double>& values);
+
+		/// <summary>
+		/// Updates weights of the net so that its value at the "previous afterstate" gets closer to the given target value
+		/// (taking into account the eligibility traces, if those are used); the afterstate and the target are
+		/// added to the replay buffer of the net (if the latter provides one)
 		/// </summary>
-		double update_z_and_evaluate_prev_after_state(const ITdlSettingsReadOnly& settings, INet& net);
+		void update_net(const double target_value, const ITdlSettingsReadOnly& settings, INet& net);
+
+		/// <summary>
+		/// Calculates afterstate of the move with the given ID and assigns it to the "previous afterstate" field
+		/// (the afterstate gets materialized only for the moves that take part in training)
+		/// </summary>
+		void assign_prev_after_state(const IMinimalStateReadonly& state, const int move_id, const INet& net);
+
+		/// <summary>
+		/// Calculates afterstate of the move with the given ID and appends it to the buffer of afterstates of the current episode
+		/// </summary>
+		void append_episode_after_state(const IMinimalStateReadonly& state, const int move_id, const INet& net);
 
 		/// <summary>
 		///	Resets training state of the object which is an obligatory procedure to start new episode
@@ -142,6 +253,32 @@ namespace TrainingCell
 		/// </summary>
 		TdLambdaSubAgent(const bool is_white);
 
+		/// <summary>
+		/// Copy constructor
+		/// </summary>
+		TdLambdaSubAgent(const TdLambdaSubAgent&) = default;
+
+		/// <summary>
+		/// Move constructor
+		/// </summary>
+		TdLambdaSubAgent(TdLambdaSubAgent&&) = default;
+
+		/// <summary>
+		/// Copy assignment operator
+		/// </summary>
+		TdLambdaSubAgent& operator =(const TdLambdaSubAgent&) = default;
+
+		/// <summary>
+		/// Move assignment operator
+		/// </summary>
+		TdLambdaSubAgent& operator =(TdLambdaSubAgent&&) = default;
+
+		/// <summary>
+		/// Destructor. Returns the eligibility traces to the pool of the current thread
+		/// (they are just freed if the pool is already destroyed, e.g., for agents with static storage duration).
+		/// </summary>
+		~TdLambdaSubAgent();
+
 		/// <summary>
 		/// Returns index of a move from the given collection of available moves
 		/// that the agent wants to take given the current state
@@ -156,6 +293,14 @@ namespace TrainingCell
 		int make_move(const IMinimalStateReadonly& state, MoveData&& move_data,
 		              const ITdlSettingsReadOnly& settings, INet& net);
 
+		/// <summary>
+		/// Coroutine version of "make_move" that "co_awaits" values of the afterstates from the given scheduler
+		/// (instead of evaluating them on its own). The picked move is exactly the same as the one that would be
+		/// picked by the regular "make_move" method given the same state of the net.
+		/// </summary>
+		CoTask<int> make_move(const IMinimalStateReadonly& state, const ITdlSettingsReadOnly& settings,
+			INet& net, EvaluationScheduler& scheduler);
+
 		/// <summary>
 		/// The method is supposed to be called by the "training environment" when the current training episode is over
 		/// to notify the agent about the "final" state and the result of entire game (episode)
@@ -174,6 +319,15 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] static MoveData pick_move(const IMinimalStateReadonly& state, const INet& net);
 
+		/// <summary>
+		/// Returns index of the picked move and the related data given the values of all the afterstates of the state
+		/// calculated via batched evaluation outside of the sub-agent (e.g., together with afterstates of other states).
+		/// The values are refined in place (see "evaluate_afterstates"), so that the picked move is exactly
+		/// the same as the one that would be picked by the regular "make_move" method.
+		/// </summary>
+		[[nodiscard]] MoveData pick_move(const IMinimalStateReadonly& state, std::vector<double>& afterstate_values,
+			const ITdlSettingsReadOnly& settings, const INet& net) const;
+
 		/// <summary>
 		/// Calculates afterstate and its value
 		/// </summary>
@@ -19,9 +19,14 @@
 #include "Agent.h"
 #include "MoveData.h"
 #include "NetWithConverter.h"
+#include "QuantizedNet.h"
 #include "TdlSettings.h"
 #include "../../DeepLearning/DeepLearning/NeuralNet/Net.h"
 #include "TdLambdaSubAgent.h"
+#include "TdlTrainingAdapter.h"
+#include "TdlActorLearner.h"
+#include "TdlLockstepEnvironment.h"
+#include "EvaluationScheduler.h"
 
 namespace TrainingCellTest
 {
@@ -65,6 +70,57 @@ namespace TrainingCell
 
 		bool _performance_evaluation_mode{false};
 
+		/// <summary>
+		/// Defines whether the quantized snapshot of the neural net should be used
+		/// to pick moves when the agent is in the "performance evaluation" mode.
+		/// </summary>
+		bool _quantized_inference_mode{false};
+
+		/// <summary>
+		/// Quantized snapshot of the neural net. It is built each time the agent switches to the mode in which the snapshot is used
+		/// (see "use_quantized_net()") and refreshed each time the net gets replaced or the agent leaves the training mode.
+		/// It is never built from "const" methods, so that the latter can be safely called concurrently.
+		/// </summary>
+		std::optional<QuantizedNet> _quantized_net{};
+
+		/// <summary>
+		/// Cache of afterstate values (disabled by default). It is not used in the training mode
+		/// and is invalidated each time the net gets replaced or the agent leaves the training mode.
+		/// </summary>
+		mutable AfterstateValueCache _value_cache{};
+
+		/// <summary>
+		/// Defines whether the neural net is updated once per training episode
+		/// (see "ITdlSettingsReadOnly::get_episode_batched_training").
+		/// </summary>
+		bool _episode_batched_training{false};
+
+		/// <summary>
+		/// Number of search episodes played concurrently (with batched evaluation of afterstates) during the TD-tree search.
+		/// </summary>
+		int _td_search_games{1};
+
+		/// <summary>
+		/// Batched inference back end used by the TD-tree search (when several search episodes are played concurrently).
+		/// </summary>
+		thread_local static EvaluationScheduler _search_scheduler;
+
+		/// <summary>
+		/// Returns "true" if moves should be picked with the help of the quantized snapshot of the neural net.
+		/// </summary>
+		[[nodiscard]] bool use_quantized_net() const;
+
+		/// <summary>
+		/// Builds the quantized snapshot of the neural net if it is going to be used (see "use_quantized_net()"), otherwise resets it.
+		/// </summary>
+		void update_quantized_net();
+
+		/// <summary>
+		/// Refreshes the quantized snapshot of the neural net and invalidates the cache of afterstate values.
+		/// Is called when the agent leaves the training mode (weights of the net can be modified only in that mode).
+		/// </summary>
+		void on_training_finished();
+
 		/// <summary>
 		/// Throws an exception if parameters of the agent are invalid/incompatible.
 		/// </summary>
@@ -98,6 +154,18 @@ namespace TrainingCell
 		/// </summary>
 		const StateConverter& converter() const override;
 
+		/// <summary>
+		/// Returns pointer to the value cache if the latter is enabled and the agent is not training
+		/// (so that its net is "frozen"), otherwise returns "nullptr".
+		/// </summary>
+		[[nodiscard]] AfterstateValueCache* value_cache() const override;
+
+		/// <summary>
+		/// Returns pointer to the experience replay buffer if experience replay is enabled
+		/// and the agent is training, otherwise returns "nullptr".
+		/// </summary>
+		[[nodiscard]] ReplayBuffer* replay_buffer() override;
+
 		/// <summary>
 		///	The neural net to approximate state value function
 		/// </summary>
@@ -125,6 +193,32 @@ namespace TrainingCell
 		/// </summary>
 		double _alpha = 0.01;
 
+		/// <summary>
+		/// Maximal number of samples in the experience replay buffer (zero means that experience replay is not used)
+		/// </summary>
+		int _replay_capacity{ 0 };
+
+		/// <summary>
+		/// Number of samples in a mini-batch drawn from the experience replay buffer
+		/// </summary>
+		int _replay_batch_size{ 32 };
+
+		/// <summary>
+		/// Number of new samples added to the experience replay buffer between two consecutive mini-batch updates
+		/// </summary>
+		int _replay_interval{ 1 };
+
+		/// <summary>
+		/// Defines whether samples are drawn from the experience replay buffer
+		/// proportionally to the magnitude of their TD-errors (otherwise uniformly)
+		/// </summary>
+		bool _replay_prioritized{ false };
+
+		/// <summary>
+		/// Experience replay buffer (created on demand according to the parameters above)
+		/// </summary>
+		ReplayBuffer _replay_buffer{};
+
 		/// <summary>
 		/// Defines whether the agent is going to train while playing
 		/// </summary>
@@ -212,7 +306,8 @@ namespace TrainingCell
 			_training_sub_mode, _lambda, _gamma, _alpha, _reward_factor,
 			_search_method, _td_search_iterations, _td_search_depth, _converter,
 			_state_type_id, _performance_evaluation_mode, _search_exploration_depth,
-			_search_exploration_probability, _search_exploration_volume)
+			_search_exploration_probability, _search_exploration_volume, _replay_capacity,
+			_replay_batch_size, _replay_interval, _replay_prioritized, _episode_batched_training)
 
 		/// <summary>
 		/// Returns script representation of all the hyper-parameters of the agent
@@ -258,6 +353,12 @@ namespace TrainingCell
 		/// </summary>
 		int make_move(const IStateReadOnly& state, const bool as_white) override;
 
+		/// <summary>
+		/// See summary of the base class declaration.
+		/// The search and the "quantized inference" modes fall back to the regular "make_move".
+		/// </summary>
+		CoTask<int> make_move_async(const IStateReadOnly& state, const bool as_white, EvaluationScheduler& scheduler) override;
+
 		/// <summary>
 		/// The method is supposed to be called by the "training environment" when the current training episode is over
 		/// to notify the agent about the "final" state and the result of entire game (episode)
@@ -349,6 +450,48 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] double get_reward_factor() const override;
 
+		/// <summary>
+		/// Sets capacity of the experience replay buffer (zero disables experience replay)
+		/// </summary>
+		void set_replay_capacity(const int capacity);
+
+		/// <summary>
+		/// Returns capacity of the experience replay buffer
+		/// </summary>
+		[[nodiscard]] int get_replay_capacity() const;
+
+		/// <summary>
+		/// Sets number of samples in a mini-batch drawn from the experience replay buffer
+		/// </summary>
+		void set_replay_batch_size(const int batch_size);
+
+		/// <summary>
+		/// Returns number of samples in a mini-batch drawn from the experience replay buffer
+		/// </summary>
+		[[nodiscard]] int get_replay_batch_size() const;
+
+		/// <summary>
+		/// Sets number of new samples added to the experience replay buffer between two consecutive mini-batch updates
+		/// </summary>
+		void set_replay_interval(const int interval);
+
+		/// <summary>
+		/// Returns number of new samples added to the experience replay buffer between two consecutive mini-batch updates
+		/// </summary>
+		[[nodiscard]] int get_replay_interval() const;
+
+		/// <summary>
+		/// Sets the flag defining whether samples are drawn from the experience replay buffer
+		/// proportionally to the magnitude of their TD-errors (otherwise uniformly)
+		/// </summary>
+		void set_replay_prioritized(const bool prioritized);
+
+		/// <summary>
+		/// Returns the flag defining whether samples are drawn from the experience replay buffer
+		/// proportionally to the magnitude of their TD-errors
+		/// </summary>
+		[[nodiscard]] bool get_replay_prioritized() const;
+
 		/// <summary>
 		/// Sets the "tree search method" parameter of the agent
 		/// </summary>
@@ -388,6 +531,33 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] int get_exploration_volume() const override;
 
+		/// <summary>
+		/// See summary of the base class.
+		/// </summary>
+		[[nodiscard]] bool get_episode_batched_training() const override;
+
+		/// <summary>
+		/// Turns on/off "episode-batched" training mode in which the afterstates of each training episode are buffered
+		/// and the neural net is updated at the end of the episode with the lambda-returns of the afterstates
+		/// (calculated with the weights the episode was played with) in a single mini-batched pass.
+		/// The mode is an "offline" counterpart of the regular (online) TD(lambda) training, so the results differ.
+		/// </summary>
+		void set_episode_batched_training(const bool value);
+
+		/// <summary>
+		/// Sets number of search episodes that are played concurrently during the TD-tree search (one by default).
+		/// Concurrent episodes are played as coroutines in the calling thread, so that their afterstates get evaluated in batches
+		/// (see "EvaluationScheduler"); each episode maintains its own eligibility traces. Within a step, values of
+		/// the afterstates of all the episodes are calculated before any of them updates the search net,
+		/// so the search results differ from those of the sequential search.
+		/// </summary>
+		void set_td_search_games(const int games_cnt);
+
+		/// <summary>
+		/// Returns number of search episodes that are played concurrently during the TD-tree search.
+		/// </summary>
+		[[nodiscard]] int get_td_search_games() const;
+
 		/// <summary>
 		/// Returns number of first moves in each search episode during which the "search" neural net should be updated
 		/// </summary>
@@ -443,6 +613,73 @@ namespace TrainingCell
 		/// </summary>
 		[[nodiscard]] bool get_performance_evaluation_mode() const;
 
+		/// <summary>
+		/// Turns on/off "sparse input" evaluation mode of the neural net (see "NetWithConverterAbstract::set_sparse_input").
+		/// </summary>
+		void set_sparse_input_mode(const bool value);
+
+		/// <summary>
+		/// Returns "true" if the "sparse input" evaluation mode of the neural net is on.
+		/// </summary>
+		[[nodiscard]] bool get_sparse_input_mode() const;
+
+		/// <summary>
+		/// Turns on/off "quantized inference" mode in which a quantized snapshot of the neural net
+		/// (8-bit weights, 16-bit activations, 32-bit accumulators) is used to pick moves
+		/// whenever the agent is in the "performance evaluation" mode and no tree search is engaged.
+		/// The values of the quantized net approximate those of the original one, so that the moves picked
+		/// in this mode can occasionally differ from those picked in the regular mode.
+		/// </summary>
+		void set_quantized_inference_mode(const bool value);
+
+		/// <summary>
+		/// Returns "true" if the "quantized inference" mode is on.
+		/// </summary>
+		[[nodiscard]] bool get_quantized_inference_mode() const;
+
+		/// <summary>
+		/// Sets capacity (number of entries) of the cache of afterstate values that is used
+		/// when the agent is not training; zero capacity (default) disables the cache.
+		/// Cached values are exactly those that the net would return, so that the cache does not affect the behaviour of the agent.
+		/// </summary>
+		void set_value_cache_capacity(const std::size_t capacity);
+
+		/// <summary>
+		/// Returns capacity of the cache of afterstate values (zero means that the cache is disabled).
+		/// </summary>
+		[[nodiscard]] std::size_t get_value_cache_capacity() const;
+
+		/// <summary>
+		/// Returns an adapter that trains the neural net of the agent (in place) with the current settings of the agent.
+		/// Each adapter maintains its own eligibility traces, so that several adapters can be used to train
+		/// the same agent concurrently (in which case the weights are updated without any synchronization, "Hogwild"-style).
+		/// The agent must outlive the adapter.
+		/// </summary>
+		[[nodiscard]] TdlTrainingAdapter create_training_adapter();
+
+		/// <summary>
+		/// Returns a learner that trains the neural net of the agent (in place) with the current settings of the agent
+		/// on the records produced by actors (see "TdlActor"). The agent must outlive the learner.
+		/// </summary>
+		[[nodiscard]] TdlLearner create_learner();
+
+		/// <summary>
+		/// Returns an environment that trains the neural net of the agent (in place) with the current settings of the agent
+		/// by playing the given number of self-play games in lockstep (see "TdlLockstepEnvironment").
+		/// The agent must outlive the environment.
+		/// </summary>
+		[[nodiscard]] TdlLockstepEnvironment create_lockstep_environment(const int games_cnt, const int max_moves_without_capture);
+
+		/// <summary>
+		/// Returns copy of the neural net of the agent together with its state converter wrapped into the given
+		/// "net with converter" type (e.g., "NetWithConverter" or "StandardFixedTopologyNet&lt;...&gt;").
+		/// </summary>
+		template <class N>
+		[[nodiscard]] N create_net_copy() const
+		{
+			return N(_net, _converter);
+		}
+
 		/// <summary>
 		/// Resets functionality that ensures randomness of the exploration component of training.
 		/// </summary>
@@ -450,6 +687,8 @@ namespace TrainingCell
 
 		/// <summary>
 		/// Frees auxiliary memory used during training, allowing to decrease memory usage of the agent by about 66%. 
+		/// Also frees the eligibility traces pooled on the current thread (see "EligibilityTracePool");
+		/// the ones pooled on other threads stay there (each of the pools is bounded by a couple of containers).
 		/// </summary>
 		void free_aux_mem();
 	};
@@ -0,0 +1,263 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "IMinimalAgent.h"
+#include "TdLambdaSubAgent.h"
+#include "TdlSettings.h"
+#include "NetWithConverter.h"
+#include "BoundedQueue.h"
+#include "INet.h"
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Per-ply training record produced by an actor and consumed by a learner.
+	/// </summary>
+	struct TdlExperienceRecord
+	{
+		/// <summary>
+		/// "Int-vector" representation of the afterstate of the taken move (empty for terminal records).
+		/// </summary>
+		std::vector<int> afterstate{};
+
+		/// <summary>
+		/// Reward received before taking the move (for terminal records -- the final reward of the episode).
+		/// </summary>
+		double reward{};
+
+		/// <summary>
+		/// "True" if the record marks the end of an episode.
+		/// </summary>
+		bool terminal{};
+
+		/// <summary>
+		/// ID of the sequence of records the current one belongs to
+		/// (each actor produces two independent sequences: one per color of pieces).
+		/// </summary>
+		int chain_id{};
+	};
+
+	/// <summary>
+	/// Queue of training records.
+	/// </summary>
+	using TdlExperienceQueue = BoundedQueue<TdlExperienceRecord>;
+
+	/// <summary>
+	/// Slot holding the latest published read-only snapshot of the neural net (that actors use to pick moves).
+	/// </summary>
+	using TdlNetSnapshotSlot = std::atomic<std::shared_ptr<NetWithConverter>>;
+
+	/// <summary>
+	/// Agent that plays with a read-only snapshot of a neural net and, instead of training,
+	/// pushes per-ply training records into the given queue (to be consumed by a learner, see "TdlLearner").
+	/// The snapshot gets refreshed at the end of each episode.
+	/// </summary>
+	class TdlActor : public IMinimalAgent
+	{
+		/// <summary>
+		/// Array of sub-agents that pick moves (the first one "plays" black pieces and the second one "plays" white pieces)
+		/// </summary>
+		std::vector<TdLambdaSubAgent> _sub_agents{ TdLambdaSubAgent{false} , TdLambdaSubAgent{true} };
+
+		/// <summary>
+		/// Settings of the training.
+		/// </summary>
+		const TdlSettings _settings;
+
+		/// <summary>
+		/// Settings used by the sub-agents (the same as the settings of the training but with training mode switched off).
+		/// </summary>
+		TdlSettings _acting_settings;
+
+		/// <summary>
+		/// State type ID.
+		/// </summary>
+		const StateTypeId _state_type_id;
+
+		/// <summary>
+		/// ID of the actor (defines IDs of the chains of records produced by the actor).
+		/// </summary>
+		const int _actor_id;
+
+		/// <summary>
+		/// Queue to push the records to.
+		/// </summary>
+		TdlExperienceQueue& _queue;
+
+		/// <summary>
+		/// Slot to take snapshots of the neural net from.
+		/// </summary>
+		const TdlNetSnapshotSlot& _snapshot_slot;
+
+		/// <summary>
+		/// Snapshot of the neural net currently in use.
+		/// </summary>
+		std::shared_ptr<NetWithConverter> _snapshot{};
+
+		/// <summary>
+		/// Number of moves taken in the current episode (per color).
+		/// </summary>
+		std::array<int, 2> _move_counter{};
+
+		/// <summary>
+		/// Previous states (per color) that are used to calculate rewards.
+		/// </summary>
+		std::array<std::vector<int>, 2> _prev_state{};
+
+		/// <summary>
+		/// Current state (a container that is swapped with the "previous state" ones to avoid allocations)
+		/// </summary>
+		std::vector<int> _current_state{};
+
+		/// <summary>
+		/// Record to be filled and pushed (a container that is swapped with the queue slots to avoid allocations).
+		/// </summary>
+		TdlExperienceRecord _record{};
+
+		/// <summary>
+		/// Pushes the record to the queue (waits while the queue is full).
+		/// </summary>
+		void push_record();
+
+		/// <summary>
+		/// Returns "true" if the move with the given number should produce a training record.
+		/// </summary>
+		[[nodiscard]] bool is_trainable(const int move_number, const bool as_white) const;
+
+	public:
+
+		/// <summary>
+		/// Default constructor removed
+		/// </summary>
+		TdlActor() = delete;
+
+		/// <summary>
+		/// Constructor
+		/// </summary>
+		/// <param name="settings">Settings of the training.</param>
+		/// <param name="state_type_id">State type ID.</param>
+		/// <param name="actor_id">ID of the actor (must be unique among the actors pushing to the same queue).</param>
+		/// <param name="queue">Queue to push the training records to.</param>
+		/// <param name="snapshot_slot">Slot to take snapshots of the neural net from (must contain a valid snapshot).</param>
+		TdlActor(const TdlSettings& settings, const StateTypeId state_type_id, const int actor_id,
+			TdlExperienceQueue& queue, const TdlNetSnapshotSlot& snapshot_slot);
+
+		/// <summary>
+		/// See summary of the base class declaration
+		/// </summary>
+		int make_move(const IStateReadOnly& state, const bool as_white) override;
+
+		/// <summary>
+		/// See summary of the base class declaration
+		/// </summary>
+		void game_over(const IStateReadOnly& final_state, const GameResult& result, const bool as_white) override;
+
+		/// <summary>
+		/// See documentation of the base class.
+		/// </summary>
+		[[nodiscard]] StateTypeId get_state_type_id() const override;
+	};
+
+	/// <summary>
+	/// Functionality that does TD(lambda) training of a neural net on the records produced by actors (see "TdlActor").
+	/// Records of each chain are supposed to come in the order they were produced
+	/// (records of different chains can be interleaved arbitrarily).
+	/// </summary>
+	class TdlLearner
+	{
+		/// <summary>
+		/// Training state of a chain of records.
+		/// </summary>
+		struct Chain
+		{
+			/// <summary>
+			/// Previous (converted) afterstate.
+			/// </summary>
+			DeepLearning::CpuDC::tensor_t prev_after_state{};
+
+			/// <summary>
+			/// Eligibility traces (are not used when "lambda" parameter is zero).
+			/// </summary>
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> z{};
+
+			/// <summary>
+			/// "True" if the traces contain values left from the previous episode of the chain
+			/// (those are discarded by the first update of the current episode).
+			/// </summary>
+			bool reset_z{};
+
+			/// <summary>
+			/// "True" if an episode is in progress.
+			/// </summary>
+			bool active{};
+		};
+
+		/// <summary>
+		/// Pointer to the net that needs to be trained
+		/// </summary>
+		INet* _net_ptr{};
+
+		/// <summary>
+		/// Settings to be used during the training
+		/// </summary>
+		const TdlSettings _settings;
+
+		/// <summary>
+		/// Training states of the chains.
+		/// </summary>
+		std::vector<Chain> _chains{};
+
+		/// <summary>
+		/// Converted afterstate of the current record.
+		/// </summary>
+		DeepLearning::CpuDC::tensor_t _after_state{};
+
+		/// <summary>
+		/// Computation context (serves optimization purposes)
+		/// </summary>
+		DeepLearning::Net<DeepLearning::CpuDC>::Context _context{};
+
+		/// <summary>
+		/// Updates weights of the net so that its value at the previous afterstate of the given chain gets closer to the given target value.
+		/// </summary>
+		void update_net(Chain& chain, const double target_value);
+
+	public:
+
+		/// <summary>
+		/// Default constructor removed
+		/// </summary>
+		TdlLearner() = delete;
+
+		/// <summary>
+		/// Constructor
+		/// </summary>
+		/// <param name="net_ptr">Pointer to a neural net to train</param>
+		/// <param name="settings">Settings to be used in the TD-lambda training process</param>
+		TdlLearner(INet* net_ptr, const TdlSettings& settings);
+
+		/// <summary>
+		/// Trains the net on the given record.
+		/// </summary>
+		void process(const TdlExperienceRecord& record);
+	};
+}
@@ -63,6 +63,18 @@ namespace TrainingCell
 		/// </summary>
 		bool _run_multi_threaded = false;
 
+		/// <summary>
+		/// Flag determining whether sub-agents pick their moves with the help of quantized snapshots of their neural nets
+		/// (see "TdlAbstractAgent::set_quantized_inference_mode"). It is a run-time setting which is not serialized.
+		/// </summary>
+		bool _quantized_inference = false;
+
+		/// <summary>
+		/// Capacity of the afterstate value caches of sub-agents (see "TdlAbstractAgent::set_value_cache_capacity").
+		/// It is a run-time setting which is not serialized.
+		/// </summary>
+		std::size_t _value_cache_capacity = 0;
+
 		/// <summary>
 		/// Returns "true" if we are in a mode when only one, "chosen", agent from the collection
 		/// is used to infer moves
@@ -254,5 +266,25 @@ namespace TrainingCell
 		/// Setter for the corresponding property.
 		/// </summary>
 		void set_run_multi_threaded(const bool run_multi_threaded);
+
+		/// <summary>
+		/// Getter for the corresponding property.
+		/// </summary>
+		[[nodiscard]] bool get_quantized_inference() const;
+
+		/// <summary>
+		/// Setter for the corresponding property.
+		/// </summary>
+		void set_quantized_inference(const bool quantized_inference);
+
+		/// <summary>
+		/// Getter for the corresponding property.
+		/// </summary>
+		[[nodiscard]] std::size_t get_value_cache_capacity() const;
+
+		/// <summary>
+		/// Setter for the corresponding property.
+		/// </summary>
+		void set_value_cache_capacity(const std::size_t capacity);
 	};
 }
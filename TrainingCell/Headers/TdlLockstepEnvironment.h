@@ -0,0 +1,89 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#pragma once
+#include "Board.h"
+#include "IStateSeed.h"
+#include "INet.h"
+#include "TdlTrainingAdapter.h"
+#include "TdlSettings.h"
+#include "StateTypeId.h"
+#include "EvaluationScheduler.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace TrainingCell
+{
+	/// <summary>
+	/// Training environment that plays the given number of self-play games "in lockstep" (in a single thread):
+	/// on each step afterstates of all the active games are evaluated by the neural net in a single batch
+	/// (see "EvaluationScheduler"), after which each game picks and takes its move and the corresponding TD(lambda)
+	/// update of the net is done. Each game is played by its own training adapter (and thus has its own eligibility traces).
+	/// A game that is over gets restarted from the start state until the required number of episodes is played.
+	/// </summary>
+	class TdlLockstepEnvironment
+	{
+		/// <summary>
+		/// Training adapters, one per game
+		/// </summary>
+		std::vector<TdlTrainingAdapter> _adapters{};
+
+		/// <summary>
+		/// Pairs of agents that play the games (each adapter plays with itself)
+		/// </summary>
+		std::vector<std::array<IMinimalAgent*, 2>> _agent_pairs{};
+
+		/// <summary>
+		/// Seed of the start state of the games
+		/// </summary>
+		std::unique_ptr<IStateSeed> _start_seed{};
+
+		/// <summary>
+		/// Maximal number of moves without a capture that will be qualified as a "draw"
+		/// </summary>
+		int _max_moves_without_capture{};
+
+		/// <summary>
+		/// Batched inference back end
+		/// </summary>
+		EvaluationScheduler _scheduler{};
+
+	public:
+		/// <summary>
+		/// Default constructor removed
+		/// </summary>
+		TdlLockstepEnvironment() = delete;
+
+		/// <summary>
+		/// Constructor
+		/// </summary>
+		/// <param name="net_ptr">Pointer to a neural net to train</param>
+		/// <param name="settings">Settings to be used in the TD-lambda training process</param>
+		/// <param name="state_type_id">Type of the state to play on</param>
+		/// <param name="games_cnt">Number of games to play in lockstep</param>
+		/// <param name="max_moves_without_capture">Maximal number of moves without a capture that will be qualified as a "draw"</param>
+		TdlLockstepEnvironment(INet* net_ptr, const TdlSettings& settings, const StateTypeId state_type_id,
+			const int games_cnt, const int max_moves_without_capture = 200);
+
+		/// <summary>
+		/// Plays the given number of self-play episodes (training the net) and returns statistics of the episodes.
+		/// Values of the afterstates of a step are calculated with the weights of the net as they were before any of the
+		/// updates done on the step; the value that is used as a TD target is always re-calculated with the up-to-date weights.
+		/// </summary>
+		Board::Stats run(const int episodes);
+	};
+}
@@ -78,6 +78,12 @@ namespace TrainingCell
 		/// (i.e. only this number of best options will be "explored").
 		/// </summary>
 		[[nodiscard]] virtual int get_exploration_volume() const = 0;
+
+		/// <summary>
+		/// Returns "true" if the neural net should be updated once per episode (with the lambda-returns
+		/// of all the afterstates of the episode in a single mini-batched pass) rather than after each move.
+		/// </summary>
+		[[nodiscard]] virtual bool get_episode_batched_training() const = 0;
 	};
 
 	/// <summary>
@@ -95,6 +101,7 @@ namespace TrainingCell
 		int _train_depth{};
 		int _exploration_depth{};
 		int _exploration_volume{};
+		bool _episode_batched_training{};
 
 	public:
 		/// <summary>
@@ -201,6 +208,17 @@ namespace TrainingCell
 		/// </summary>
 		void set_exploration_volume(const int volume);
 
+		/// <summary>
+		/// Returns "true" if the neural net should be updated once per episode (with the lambda-returns
+		/// of all the afterstates of the episode in a single mini-batched pass) rather than after each move.
+		/// </summary>
+		[[nodiscard]] bool get_episode_batched_training() const override;
+
+		/// <summary>
+		/// Setter for the corresponding property
+		/// </summary>
+		void set_episode_batched_training(const bool episode_batched_training);
+
 		/// <summary>
 		/// Equality operator.
 		/// </summary>
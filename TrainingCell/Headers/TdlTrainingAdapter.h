@@ -66,6 +66,11 @@ namespace TrainingCell
 		/// </summary>
 		int make_move(const IStateReadOnly& state, const bool as_white) override;
 
+		/// <summary>
+		/// See summary of the base class declaration
+		/// </summary>
+		CoTask<int> make_move_async(const IStateReadOnly& state, const bool as_white, EvaluationScheduler& scheduler) override;
+
 		/// <summary>
 		/// See summary of the base class declaration
 		/// </summary>
@@ -19,6 +19,7 @@
 #include <vector>
 #include <array>
 #include "TdLambdaAgent.h"
+#include "Board.h"
 #include <functional>
 #include "msgpack.hpp"
 
@@ -118,6 +119,21 @@ namespace TrainingCell
 		/// Maximal number of consequent moves without a capture that will be qualified as a draw.
 		/// </summary>
 		static constexpr int _max_moves_without_capture = 50;
+
+		/// <summary>
+		/// Capacity of the queue of training records used in the "actor-learner" training.
+		/// </summary>
+		static constexpr int _actor_learner_queue_capacity = 1 << 12;
+
+		/// <summary>
+		/// Runs auto-training rounds in which agents are trained one after another by the given "trainer"
+		/// (that is supposed to utilize all the cores to train a single agent).
+		/// </summary>
+		void run_auto_sequential(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+			const std::function<void(const long long& time_per_round_ms,
+				const std::vector<PerformanceRec>& agent_performances)>& round_callback,
+			const std::function<Board::Stats(TdLambdaAgent& agent)>& trainer,
+			const int test_episodes_cnt, const bool remove_outliers) const;
 	public:
 
 		/// <summary>
@@ -176,5 +192,91 @@ namespace TrainingCell
 			const std::function<void(const long long& time_per_round_ms,
 				const std::vector<PerformanceRec>& agent_performances)>& round_callback,
 			const int test_episodes_cnt = 1000, const bool smart_training = false, const bool remove_outliers = false) const;
+
+		/// <summary>
+		/// Method to run "Hogwild" auto-training, in which each agent is trained by the given number of threads
+		/// that play independent self-play episodes and update weights of the agent concurrently without any synchronization
+		/// (each thread maintains its own eligibility traces). Agents are trained one after another, so that
+		/// a single agent can utilize all the cores.
+		/// </summary>
+		/// <param name="round_id_start">Id of the round to start with.</param>
+		/// <param name="max_round_id">ID of the maximal round plus one.</param>
+		/// <param name="training_episodes_cnt">Number of episodes in a round to play (per agent, in total for all the threads)</param>
+		/// <param name="round_callback">Call-back function that is called after
+		/// each round to provide some intermediate information to the caller</param>
+		/// <param name="threads_cnt">Number of threads to train each agent.</param>
+		/// <param name="test_episodes_cnt">Number of episodes to run when evaluating performance of trained agents</param>
+		/// <param name="remove_outliers">If "true" agents with low score will be substituted
+		/// with copies of best-score agents (on a round basis).</param>
+		void run_auto_hogwild(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+			const std::function<void(const long long& time_per_round_ms,
+				const std::vector<PerformanceRec>& agent_performances)>& round_callback,
+			const int threads_cnt, const int test_episodes_cnt = 1000, const bool remove_outliers = false) const;
+
+		/// <summary>
+		/// Runs the given number of "Hogwild" self-play training episodes of the given agent
+		/// (see "run_auto_hogwild") in the given number of concurrent threads.
+		/// Experience replay is not supported (its buffer is not thread-safe).
+		/// Returns statistics of the episodes.
+		/// </summary>
+		static Board::Stats train_hogwild(TdLambdaAgent& agent, const int episodes, const int threads_cnt);
+
+		/// <summary>
+		/// Method to run "actor-learner" auto-training, in which each agent is trained by a single learner thread
+		/// that does TD(lambda) updates of the weights of the agent on per-ply records produced by the given number of actor threads.
+		/// Actors play self-play episodes with a read-only snapshot of the net of the agent (which gets refreshed periodically)
+		/// and push the records into a bounded lock-free queue. Agents are trained one after another.
+		/// </summary>
+		/// <param name="round_id_start">Id of the round to start with.</param>
+		/// <param name="max_round_id">ID of the maximal round plus one.</param>
+		/// <param name="training_episodes_cnt">Number of episodes in a round to play (per agent, in total for all the actors)</param>
+		/// <param name="round_callback">Call-back function that is called after
+		/// each round to provide some intermediate information to the caller</param>
+		/// <param name="actors_cnt">Number of actor threads to train each agent.</param>
+		/// <param name="snapshot_refresh_interval">Number of records to process by the learner
+		/// before a new snapshot of the net gets published to the actors.</param>
+		/// <param name="test_episodes_cnt">Number of episodes to run when evaluating performance of trained agents</param>
+		/// <param name="remove_outliers">If "true" agents with low score will be substituted
+		/// with copies of best-score agents (on a round basis).</param>
+		void run_auto_actor_learner(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+			const std::function<void(const long long& time_per_round_ms,
+				const std::vector<PerformanceRec>& agent_performances)>& round_callback,
+			const int actors_cnt, const int snapshot_refresh_interval = 1000,
+			const int test_episodes_cnt = 1000, const bool remove_outliers = false) const;
+
+		/// <summary>
+		/// Runs the given number of "actor-learner" self-play training episodes of the given agent
+		/// (see "run_auto_actor_learner") with the given number of actor threads
+		/// (the learner runs in the calling thread). Experience replay is not supported (the learner does not use it).
+		/// Returns statistics of the episodes.
+		/// </summary>
+		static Board::Stats train_actor_learner(TdLambdaAgent& agent, const int episodes, const int actors_cnt,
+			const int snapshot_refresh_interval);
+
+		/// <summary>
+		/// Method to run "lockstep" auto-training, in which each agent is trained in a single thread that plays the given number
+		/// of self-play games in lockstep, so that afterstates of all the games are evaluated by the net of the agent in a single batch
+		/// (see "TdlLockstepEnvironment"). Different agents are trained concurrently.
+		/// </summary>
+		/// <param name="round_id_start">Id of the round to start with.</param>
+		/// <param name="max_round_id">ID of the maximal round plus one.</param>
+		/// <param name="training_episodes_cnt">Number of episodes in a round to play (per agent)</param>
+		/// <param name="round_callback">Call-back function that is called after
+		/// each round to provide some intermediate information to the caller</param>
+		/// <param name="games_cnt">Number of games each agent plays in lockstep.</param>
+		/// <param name="test_episodes_cnt">Number of episodes to run when evaluating performance of trained agents</param>
+		/// <param name="remove_outliers">If "true" agents with low score will be substituted
+		/// with copies of best-score agents (on a round basis).</param>
+		void run_auto_lockstep(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+			const std::function<void(const long long& time_per_round_ms,
+				const std::vector<PerformanceRec>& agent_performances)>& round_callback,
+			const int games_cnt, const int test_episodes_cnt = 1000, const bool remove_outliers = false) const;
+
+		/// <summary>
+		/// Runs the given number of "lockstep" self-play training episodes of the given agent
+		/// (see "run_auto_lockstep") with the given number of games played in lockstep.
+		/// Returns statistics of the episodes.
+		/// </summary>
+		static Board::Stats train_lockstep(TdLambdaAgent& agent, const int episodes, const int games_cnt);
 	};
 }
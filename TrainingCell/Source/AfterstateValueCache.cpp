@@ -0,0 +1,119 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/AfterstateValueCache.h"
+#include <bit>
+
+namespace TrainingCell
+{
+	namespace
+	{
+		/// <summary>
+		/// "Finalizer" of the split-mix 64-bit generator (maps the given value to a pseudo-random one).
+		/// </summary>
+		constexpr std::uint64_t mix(std::uint64_t x)
+		{
+			x += 0x9e3779b97f4a7c15ull;
+			x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+			x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+			return x ^ (x >> 31);
+		}
+	}
+
+	std::uint64_t AfterstateValueCache::to_key(const std::uint64_t hash) const
+	{
+		return hash ^ mix(_generation.load(std::memory_order_relaxed));
+	}
+
+	AfterstateValueCache::AfterstateValueCache(const std::size_t capacity)
+	{
+		set_capacity(capacity);
+	}
+
+	AfterstateValueCache::AfterstateValueCache(const AfterstateValueCache& another_cache) :
+		AfterstateValueCache(another_cache.get_capacity())
+	{}
+
+	AfterstateValueCache& AfterstateValueCache::operator=(const AfterstateValueCache& another_cache)
+	{
+		if (this != &another_cache)
+			set_capacity(another_cache.get_capacity());
+
+		return *this;
+	}
+
+	void AfterstateValueCache::set_capacity(const std::size_t capacity)
+	{
+		_capacity = capacity == 0 ? 0 : std::bit_ceil(capacity);
+		_slots = _capacity == 0 ? nullptr : std::make_unique<Slot[]>(_capacity);
+		invalidate();
+	}
+
+	std::size_t AfterstateValueCache::get_capacity() const
+	{
+		return _capacity;
+	}
+
+	bool AfterstateValueCache::is_enabled() const
+	{
+		return _capacity != 0;
+	}
+
+	void AfterstateValueCache::invalidate()
+	{
+		_generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool AfterstateValueCache::try_get(const std::uint64_t hash, double& out_value) const
+	{
+		if (!is_enabled())
+			return false;
+
+		const auto& slot = _slots[hash & (_capacity - 1)];
+		const auto data = slot.data.load(std::memory_order_relaxed);
+
+		if ((slot.check.load(std::memory_order_relaxed) ^ data) != to_key(hash))
+			return false;
+
+		out_value = std::bit_cast<double>(data);
+		return true;
+	}
+
+	void AfterstateValueCache::put(const std::uint64_t hash, const double value)
+	{
+		if (!is_enabled())
+			return;
+
+		auto& slot = _slots[hash & (_capacity - 1)];
+		const auto data = std::bit_cast<std::uint64_t>(value);
+		slot.check.store(to_key(hash) ^ data, std::memory_order_relaxed);
+		slot.data.store(data, std::memory_order_relaxed);
+	}
+
+	std::uint64_t AfterstateValueCache::calc_hash(const std::vector<int>& state)
+	{
+		auto result = mix(state.size());
+
+		for (auto item_id = 0ull; item_id < state.size(); ++item_id)
+		{
+			if (state[item_id] != 0)
+				result ^= mix(item_id << 32 | static_cast<std::uint32_t>(state[item_id]));
+		}
+
+		return result;
+	}
+}
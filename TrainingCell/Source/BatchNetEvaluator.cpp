@@ -0,0 +1,234 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/BatchNetEvaluator.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace TrainingCell
+{
+	void BatchNetEvaluator::act_linear(const DenseLayerView& layer, const DeepLearning::Real* in, const int items_count,
+		DeepLearning::Real* out)
+	{
+		constexpr int block_size = 4;
+		const auto in_size = layer.in_size;
+		const auto out_size = layer.out_size;
+		const auto full_blocks_end = items_count - items_count % block_size;
+
+		// Each row of the weight matrix is applied to a block of items at once
+		// so that the row is loaded from memory once per block rather than once per item
+		for (auto row_id = 0; row_id < out_size; ++row_id)
+		{
+			const auto weights = layer.weights + static_cast<std::size_t>(row_id) * in_size;
+			const auto bias = layer.biases[row_id];
+
+			auto item_id = 0;
+			for (; item_id < full_blocks_end; item_id += block_size)
+			{
+				const auto in_0 = in + static_cast<std::size_t>(item_id) * in_size;
+				const auto in_1 = in_0 + in_size;
+				const auto in_2 = in_1 + in_size;
+				const auto in_3 = in_2 + in_size;
+
+				DeepLearning::Real sum_0 = bias;
+				DeepLearning::Real sum_1 = bias;
+				DeepLearning::Real sum_2 = bias;
+				DeepLearning::Real sum_3 = bias;
+
+				for (auto col_id = 0; col_id < in_size; ++col_id)
+				{
+					const auto w = weights[col_id];
+					sum_0 += w * in_0[col_id];
+					sum_1 += w * in_1[col_id];
+					sum_2 += w * in_2[col_id];
+					sum_3 += w * in_3[col_id];
+				}
+
+				out[static_cast<std::size_t>(item_id) * out_size + row_id] = sum_0;
+				out[static_cast<std::size_t>(item_id + 1) * out_size + row_id] = sum_1;
+				out[static_cast<std::size_t>(item_id + 2) * out_size + row_id] = sum_2;
+				out[static_cast<std::size_t>(item_id + 3) * out_size + row_id] = sum_3;
+			}
+
+			for (; item_id < items_count; ++item_id)
+			{
+				const auto in_item = in + static_cast<std::size_t>(item_id) * in_size;
+				DeepLearning::Real sum = bias;
+
+				for (auto col_id = 0; col_id < in_size; ++col_id)
+					sum += weights[col_id] * in_item[col_id];
+
+				out[static_cast<std::size_t>(item_id) * out_size + row_id] = sum;
+			}
+		}
+	}
+
+	void BatchNetEvaluator::act_linear_incremental(const DenseLayerView& layer, DeepLearning::Real* out)
+	{
+		const auto in_size = layer.in_size;
+		const auto out_size = layer.out_size;
+
+		_base_accumulator.resize(out_size);
+		act_linear(layer, _base_item.data(), 1, _base_accumulator.data());
+
+		// If an item differs from the "base" one in too many elements
+		// it is cheaper to evaluate it in the "dense" way
+		const auto max_diff_elements = in_size / 4;
+
+		for (auto item_id = 0; item_id < _batch_size; ++item_id)
+		{
+			const auto in_item = item(item_id);
+			const auto out_item = out + static_cast<std::size_t>(item_id) * out_size;
+
+			const auto diff_elements = static_cast<int>(std::inner_product(in_item, in_item + in_size,
+				_base_item.begin(), 0ll, std::plus(), std::not_equal_to()));
+
+			if (diff_elements > max_diff_elements)
+			{
+				act_linear(layer, in_item, 1, out_item);
+				continue;
+			}
+
+			std::ranges::copy(_base_accumulator, out_item);
+
+			for (auto col_id = 0; col_id < in_size; ++col_id)
+			{
+				const auto diff = in_item[col_id] - _base_item[col_id];
+
+				if (diff == 0)
+					continue;
+
+				const auto weights_col = layer.weights + col_id;
+				for (auto row_id = 0; row_id < out_size; ++row_id)
+					out_item[row_id] += diff * weights_col[static_cast<std::size_t>(row_id) * in_size];
+			}
+		}
+	}
+
+	void BatchNetEvaluator::act_linear_sparse(const DenseLayerView& layer, DeepLearning::Real* out) const
+	{
+		const auto in_size = layer.in_size;
+		const auto out_size = layer.out_size;
+
+		for (auto item_id = 0; item_id < _batch_size; ++item_id)
+		{
+			const auto& sparse_item = _sparse_items[item_id];
+			const auto non_zero_count = sparse_item.ids.size();
+			const auto out_item = out + static_cast<std::size_t>(item_id) * out_size;
+
+			for (auto row_id = 0; row_id < out_size; ++row_id)
+			{
+				const auto weights = layer.weights + static_cast<std::size_t>(row_id) * in_size;
+				DeepLearning::Real sum = layer.biases[row_id];
+
+				for (auto element_id = 0ull; element_id < non_zero_count; ++element_id)
+					sum += sparse_item.values[element_id] * weights[sparse_item.ids[element_id]];
+
+				out_item[row_id] = sum;
+			}
+		}
+	}
+
+	void BatchNetEvaluator::reset(const int batch_size, const int item_size)
+	{
+		_batch_size = batch_size;
+		_item_size = item_size;
+
+		if (_first_layer_mode == FirstLayerMode::Fused)
+		{
+			if (_sparse_items.size() < static_cast<std::size_t>(batch_size))
+				_sparse_items.resize(batch_size);
+
+			return;
+		}
+
+		_input.resize(static_cast<std::size_t>(batch_size) * item_size);
+		_base_item.resize(item_size);
+	}
+
+	SparseState& BatchNetEvaluator::sparse_item(const int item_id)
+	{
+		return _sparse_items[item_id];
+	}
+
+	DeepLearning::Real* BatchNetEvaluator::item(const int item_id)
+	{
+		return _input.data() + static_cast<std::size_t>(item_id) * _item_size;
+	}
+
+	DeepLearning::Real* BatchNetEvaluator::base_item()
+	{
+		return _base_item.data();
+	}
+
+	void BatchNetEvaluator::set_first_layer_mode(const FirstLayerMode mode)
+	{
+		_first_layer_mode = mode;
+	}
+
+	FirstLayerMode BatchNetEvaluator::get_first_layer_mode() const
+	{
+		return _first_layer_mode;
+	}
+
+	std::vector<int>& BatchNetEvaluator::aux_state()
+	{
+		return _aux_state;
+	}
+
+	void BatchNetEvaluator::evaluate(const DeepLearning::Net<DeepLearning::CpuDC>& net)
+	{
+		DenseLayerView::extract(net, _layers);
+
+		if (_layers.empty() || _layers.begin()->in_size != _item_size || _layers.rbegin()->out_size != 1)
+			throw std::exception("The net is incompatible with the batch.");
+
+		const DeepLearning::Real* in = _input.data();
+		auto buffer_id = 0;
+
+		for (auto layer_id = 0ull; layer_id < _layers.size(); ++layer_id)
+		{
+			const auto& layer = _layers[layer_id];
+			auto& out = _buffers[buffer_id];
+			out.resize(static_cast<std::size_t>(_batch_size) * layer.out_size);
+
+			if (layer_id == 0 && _first_layer_mode == FirstLayerMode::Incremental)
+				act_linear_incremental(layer, out.data());
+			else if (layer_id == 0 && _first_layer_mode == FirstLayerMode::Fused)
+				act_linear_sparse(layer, out.data());
+			else
+				act_linear(layer, in, _batch_size, out.data());
+
+			layer.activate(out.data(), _batch_size * layer.out_size);
+			in = out.data();
+			buffer_id ^= 1;
+		}
+
+		_values.assign(in, in + _batch_size);
+	}
+
+	const std::vector<double>& BatchNetEvaluator::values() const
+	{
+		return _values;
+	}
+
+	std::vector<double>& BatchNetEvaluator::values()
+	{
+		return _values;
+	}
+}
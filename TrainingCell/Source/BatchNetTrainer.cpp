@@ -0,0 +1,224 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/BatchNetTrainer.h"
+#include <algorithm>
+
+namespace TrainingCell
+{
+	void BatchNetTrainer::forward(const DeepLearning::Net<DeepLearning::CpuDC>& net)
+	{
+		DenseLayerView::extract(net, _layers);
+
+		if (_layers.empty() || _layers.front().in_size != _input_size || _layers.back().out_size != 1)
+			throw std::exception("The net is incompatible with the inputs.");
+
+		const auto layers_count = _layers.size();
+		_pre_activations.resize(layers_count);
+		_activations.resize(layers_count);
+
+		for (auto layer_id = 0ull; layer_id < layers_count; ++layer_id)
+		{
+			const auto& layer = _layers[layer_id];
+			const auto& in = layer_id == 0 ? _inputs : _activations[layer_id - 1];
+			auto& pre_activation = _pre_activations[layer_id];
+			pre_activation.resize(static_cast<std::size_t>(_batch_size) * layer.out_size);
+
+			// rows of the weight matrix are iterated in the outer loop so that each of them is loaded once per batch
+			for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+			{
+				const auto weights_row = layer.weights + static_cast<std::size_t>(row_id) * layer.in_size;
+				const auto bias = layer.biases[row_id];
+
+				for (auto item_id = 0; item_id < _batch_size; ++item_id)
+				{
+					const auto in_row = in.data() + static_cast<std::size_t>(item_id) * layer.in_size;
+					DeepLearning::Real sum = bias;
+
+					for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+						sum += weights_row[col_id] * in_row[col_id];
+
+					pre_activation[static_cast<std::size_t>(item_id) * layer.out_size + row_id] = sum;
+				}
+			}
+
+			auto& activation = _activations[layer_id];
+			activation = pre_activation;
+			layer.activate(activation.data(), static_cast<int>(activation.size()));
+		}
+
+		const auto& out = _activations.back();
+		_values.assign(out.begin(), out.end());
+	}
+
+	void BatchNetTrainer::backward(DeepLearning::Net<DeepLearning::CpuDC>& net, const std::vector<double>& steps)
+	{
+		// derivatives of the (one-dimensional) outputs with respect to themselves scaled with the steps
+		_deltas[0].resize(_batch_size);
+		std::transform(steps.begin(), steps.begin() + _batch_size, _deltas[0].begin(),
+			[](const auto x) { return static_cast<DeepLearning::Real>(x); });
+		auto delta_id = 0;
+
+		for (auto layer_id = static_cast<int>(_layers.size()) - 1; layer_id >= 0; --layer_id)
+		{
+			const auto& layer = _layers[layer_id];
+			const auto& pre_activation = _pre_activations[layer_id];
+			auto& delta = _deltas[delta_id];
+
+			if (layer.func_id == DeepLearning::ActivationFunctionId::RELU)
+			{
+				for (auto element_id = 0ull; element_id < delta.size(); ++element_id)
+				{
+					if (pre_activation[element_id] <= 0)
+						delta[element_id] = 0;
+				}
+			}
+
+			// the net is accessed via a non-constant reference, so that the parameters can be modified
+			const auto weights = const_cast<DeepLearning::Real*>(layer.weights);
+			const auto biases = const_cast<DeepLearning::Real*>(layer.biases);
+
+			const auto& in = layer_id == 0 ? _inputs : _activations[layer_id - 1];
+			auto& delta_next = _deltas[delta_id ^ 1];
+
+			if (layer_id > 0)
+				delta_next.assign(static_cast<std::size_t>(_batch_size) * layer.in_size, static_cast<DeepLearning::Real>(0));
+
+			for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+			{
+				const auto weights_row = weights + static_cast<std::size_t>(row_id) * layer.in_size;
+
+				// derivatives are calculated with the weights before the update
+				if (layer_id > 0)
+				{
+					for (auto item_id = 0; item_id < _batch_size; ++item_id)
+					{
+						const auto item_delta = delta[static_cast<std::size_t>(item_id) * layer.out_size + row_id];
+
+						if (item_delta == 0)
+							continue;
+
+						const auto delta_next_row = delta_next.data() + static_cast<std::size_t>(item_id) * layer.in_size;
+
+						for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+							delta_next_row[col_id] += weights_row[col_id] * item_delta;
+					}
+				}
+
+				for (auto item_id = 0; item_id < _batch_size; ++item_id)
+				{
+					const auto item_delta = delta[static_cast<std::size_t>(item_id) * layer.out_size + row_id];
+
+					if (item_delta == 0)
+						continue;
+
+					biases[row_id] += item_delta;
+					const auto in_row = in.data() + static_cast<std::size_t>(item_id) * layer.in_size;
+
+					for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+						weights_row[col_id] += item_delta * in_row[col_id];
+				}
+			}
+
+			delta_id ^= 1;
+		}
+	}
+
+	void BatchNetTrainer::assign_inputs(const std::vector<DeepLearning::CpuDC::tensor_t>& inputs, const int count)
+	{
+		if (count <= 0 || count > static_cast<int>(inputs.size()))
+			throw std::exception("Invalid number of inputs");
+
+		_batch_size = count;
+		_input_size = static_cast<int>(inputs[0].size());
+		_inputs.resize(static_cast<std::size_t>(_batch_size) * _input_size);
+
+		for (auto item_id = 0; item_id < _batch_size; ++item_id)
+		{
+			const auto& input = inputs[item_id];
+
+			if (static_cast<int>(input.size()) != _input_size)
+				throw std::exception("Inputs must be of the same size");
+
+			std::copy(input.begin(), input.end(), _inputs.begin() + static_cast<std::size_t>(item_id) * _input_size);
+		}
+	}
+
+	void BatchNetTrainer::assign_inputs(const std::vector<DeepLearning::Real>& inputs, const int count)
+	{
+		if (count <= 0 || inputs.size() % count != 0)
+			throw std::exception("Invalid number of inputs");
+
+		_batch_size = count;
+		_input_size = static_cast<int>(inputs.size() / count);
+		_inputs = inputs;
+	}
+
+	const std::vector<double>& BatchNetTrainer::evaluate(const DeepLearning::Net<DeepLearning::CpuDC>& net)
+	{
+		forward(net);
+		return _values;
+	}
+
+	void BatchNetTrainer::calc_lambda_returns(const std::vector<double>& values, const std::vector<double>& rewards,
+		const int count, const double discount, const double lambda, std::vector<double>& out_returns)
+	{
+		out_returns.resize(count);
+
+		if (count <= 0)
+			return;
+
+		out_returns[count - 1] = rewards[count - 1];
+
+		for (auto item_id = count - 2; item_id >= 0; --item_id)
+			out_returns[item_id] = rewards[item_id] + discount *
+				((1.0 - lambda) * values[item_id + 1] + lambda * out_returns[item_id + 1]);
+	}
+
+	void BatchNetTrainer::td_lambda_return_update(DeepLearning::Net<DeepLearning::CpuDC>& net, const std::vector<double>& rewards,
+		const double learning_rate, const double discount, const double lambda)
+	{
+		if (static_cast<int>(rewards.size()) < _batch_size)
+			throw std::exception("Invalid number of rewards");
+
+		forward(net);
+		calc_lambda_returns(_values, rewards, _batch_size, discount, lambda, _returns);
+
+		// the returns are turned into steps in place
+		for (auto item_id = 0; item_id < _batch_size; ++item_id)
+			_returns[item_id] = learning_rate * (_returns[item_id] - _values[item_id]);
+
+		backward(net, _returns);
+	}
+
+	const std::vector<double>& BatchNetTrainer::regression_update(DeepLearning::Net<DeepLearning::CpuDC>& net,
+		const std::vector<double>& targets, const double learning_rate)
+	{
+		if (static_cast<int>(targets.size()) < _batch_size)
+			throw std::exception("Invalid number of targets");
+
+		forward(net);
+
+		_returns.resize(_batch_size);
+		for (auto item_id = 0; item_id < _batch_size; ++item_id)
+			_returns[item_id] = learning_rate * (targets[item_id] - _values[item_id]);
+
+		backward(net, _returns);
+
+		return _values;
+	}
+}
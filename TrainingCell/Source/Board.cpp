@@ -17,6 +17,8 @@
 
 #include "../Headers/Board.h"
 #include "../Headers/StateTypeController.h"
+#include "../Headers/EvaluationScheduler.h"
+#include "../Headers/EpisodeTrace.h"
 
 namespace TrainingCell
 {
@@ -131,19 +133,44 @@ namespace TrainingCell
 
 	template <class A>
 	Board::EpisodeResult Board::play_episode(IState& state, AgentManager<A>& agent_manager,
-		const int max_moves_without_capture, PublishStateCallBack publish_state_callback, CancelCallBack cancel)
+		const int max_moves_without_capture, PublishStateCallBack publish_state_callback, CancelCallBack cancel,
+		EpisodeTrace* trace)
 	{
 		auto moves_without_capture = 0;
 		publish_state(publish_state_callback, state, Move{}, agent_manager.agent_to_move());
 		while (state.get_moves_count() > 0 && moves_without_capture <= max_moves_without_capture && !state.is_draw())
 		{
-			const auto is_capture_move = make_move(state, agent_manager, publish_state_callback);
+			const auto is_capture_move = make_move(state, agent_manager, publish_state_callback, trace);
 			moves_without_capture = is_capture_move ? 0 : (moves_without_capture + 1);
 
 			if (cancel != nullptr && cancel())
 				break;//this will be qualified as a "draw"
 		}
 
+		return finish_episode(state, agent_manager);
+	}
+
+	template <class A>
+	Board::EpisodeResult Board::replay_episode(EpisodeTrace& trace, const IState& final_state, AgentManager<A>& agent_manager)
+	{
+		for (auto ply_id = 0; ply_id < trace.get_plies_count(); ++ply_id)
+		{
+			trace.set_current_ply(ply_id);
+			const auto chosen_move_id = agent_manager.agent_to_move().make_move(trace, agent_manager.is_agent_to_move_white());
+
+			// sanity check
+			if (chosen_move_id != 0)
+				throw std::exception("Invalid move id");
+
+			agent_manager.take_turn();
+		}
+
+		return finish_episode(final_state, agent_manager);
+	}
+
+	template <class A>
+	Board::EpisodeResult Board::finish_episode(const IState& state, AgentManager<A>& agent_manager)
+	{
 		EpisodeResult result;
 		if (state.get_moves_count() <= 0 && !state.is_draw()) //win case
 		{
@@ -179,13 +206,14 @@ namespace TrainingCell
 
 		try
 		{
+			std::unique_ptr<IState> state_ptr;
 			for (auto episode_id = 1; episode_id <= episodes; episode_id++)
 			{
 				if (cancel != nullptr && cancel())
 					return { blacks_win_counter, whites_win_counter, episode_id - 1 };
 
 				agent_manager.reset();
-				auto state_ptr = start_state.yield(/*initialize_recorder*/ false);
+				start_state.yield(state_ptr, /*initialize_recorder*/ false);
 
 				const auto episode_result = play_episode(*state_ptr, agent_manager,
 					max_moves_without_capture, publish_state_callback, cancel);
@@ -213,7 +241,7 @@ namespace TrainingCell
 	Board::Stats Board::train(ITrainableAgent* const agent_white_ptr, ITrainableAgent* const agent_black_ptr,
 		const int episodes, const IStateSeed& start_state, const int max_moves_without_capture,
 		const int  max_consequent_draw_episodes, PublishEndEpisodeStatsCallBack publish_end_episode_stats_callback, CancelCallBack cancel,
-		ErrorMessageCallBack error)
+		ErrorMessageCallBack error, const bool single_pass)
 	{
 		AgentManagerAdv agent_manager(agent_white_ptr, agent_black_ptr);
 
@@ -228,6 +256,8 @@ namespace TrainingCell
 		{
 			auto episode_id = 0;
 			auto consequent_draw_episodes = 0;
+			EpisodeTrace trace;
+			std::unique_ptr<IState> state_ptr;
 			while (episode_id < episodes)
 			{
 				if (cancel != nullptr && cancel())
@@ -236,10 +266,13 @@ namespace TrainingCell
 				total_episodes_count++;
 				agent_manager.reset();
 				agent_manager.set_exploration_mode();
-				auto state_ptr = start_state.yield(/*initialize_recorder*/ true);
+				start_state.yield(state_ptr, /*initialize_recorder*/ !single_pass);
+
+				if (single_pass)
+					trace.reset(*state_ptr);
 
 				const auto episode_result = play_episode(*state_ptr, agent_manager,
-					max_moves_without_capture, nullptr, cancel);
+					max_moves_without_capture, nullptr, cancel, single_pass ? &trace : nullptr);
 
 				if (episode_result == Draw && consequent_draw_episodes < max_consequent_draw_episodes)
 				{
@@ -251,10 +284,9 @@ namespace TrainingCell
 				episode_id++;
 				agent_manager.reset();
 				agent_manager.set_training_mode();
-				auto recorder_state_ptr = state_ptr->get_recorded_state();
 
-				const auto replay_episode_result = play_episode(*recorder_state_ptr, agent_manager,
-					max_moves_without_capture, nullptr, cancel);
+				const auto replay_episode_result = single_pass ? replay_episode(trace, *state_ptr, agent_manager) :
+					play_episode(*state_ptr->get_recorded_state(), agent_manager, max_moves_without_capture, nullptr, cancel);
 
 				if (replay_episode_result != episode_result)
 					throw std::exception("Result of exploration episode differs from that of the re-play episode");
@@ -280,10 +312,21 @@ namespace TrainingCell
 	}
 
 	template <class A>
-	bool Board::make_move(IState& state_handle, AgentManager<A>& agent_manager, PublishStateCallBack publish)
+	bool Board::make_move(IState& state_handle, AgentManager<A>& agent_manager, PublishStateCallBack publish,
+		EpisodeTrace* trace)
 	{
 		const auto chosen_move_id = agent_manager.agent_to_move().make_move(state_handle, agent_manager.is_agent_to_move_white());
 
+		if (trace != nullptr)
+			trace->add_ply(state_handle, chosen_move_id);
+
+		return take_move(state_handle, agent_manager, chosen_move_id, publish);
+	}
+
+	template <class A>
+	bool Board::take_move(IState& state_handle, AgentManager<A>& agent_manager, const int chosen_move_id,
+		PublishStateCallBack publish)
+	{
 		// sanity check
 		if (chosen_move_id < 0 || chosen_move_id >= state_handle.get_moves_count())
 			throw std::exception("Invalid move id");
@@ -306,4 +349,53 @@ namespace TrainingCell
 
 		return is_capture_move;
 	}
+
+	CoTask<void> Board::play_episodes_async(IMinimalAgent* const agent_white_ptr, IMinimalAgent* const agent_black_ptr,
+		int& episodes_to_play, const IStateSeed& start_state, const int max_moves_without_capture,
+		EvaluationScheduler& scheduler, int& blacks_win_counter, int& whites_win_counter)
+	{
+		AgentManager agent_manager(agent_white_ptr, agent_black_ptr);
+		std::unique_ptr<IState> state_ptr;
+
+		while (episodes_to_play > 0)
+		{
+			--episodes_to_play;
+			agent_manager.reset();
+			start_state.yield(state_ptr, /*initialize_recorder*/ false);
+			auto& state = *state_ptr;
+			auto moves_without_capture = 0;
+
+			while (state.get_moves_count() > 0 && moves_without_capture <= max_moves_without_capture && !state.is_draw())
+			{
+				const auto chosen_move_id = co_await agent_manager.agent_to_move().make_move_async(state,
+					agent_manager.is_agent_to_move_white(), scheduler);
+				const auto is_capture_move = take_move(state, agent_manager, chosen_move_id, nullptr);
+				moves_without_capture = is_capture_move ? 0 : (moves_without_capture + 1);
+			}
+
+			const auto episode_result = finish_episode(state, agent_manager);
+			whites_win_counter += episode_result == WhiteVictory;
+			blacks_win_counter += episode_result == BlackVictory;
+		}
+	}
+
+	Board::Stats Board::play(const std::vector<std::array<IMinimalAgent*, 2>>& agent_pairs, const int episodes,
+		const IStateSeed& start_state, const int max_moves_without_capture, EvaluationScheduler& scheduler)
+	{
+		for (const auto& [agent_white_ptr, agent_black_ptr] : agent_pairs)
+			if (!StateTypeController::validate(*agent_white_ptr, *agent_black_ptr, start_state))
+				throw std::exception("Agents and state incompatible.");
+
+		auto episodes_to_play = episodes;
+		int blacks_win_counter = 0;
+		int whites_win_counter = 0;
+
+		for (const auto& [agent_white_ptr, agent_black_ptr] : agent_pairs)
+			scheduler.spawn(play_episodes_async(agent_white_ptr, agent_black_ptr, episodes_to_play, start_state,
+				max_moves_without_capture, scheduler, blacks_win_counter, whites_win_counter));
+
+		scheduler.run();
+
+		return { blacks_win_counter, whites_win_counter, episodes };
+	}
 }
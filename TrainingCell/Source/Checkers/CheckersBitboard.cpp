@@ -0,0 +1,216 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../../Headers/Checkers/CheckersBitboard.h"
+#include <bit>
+
+namespace TrainingCell::Checkers
+{
+	/// <summary>
+	/// Fields of the even rows (the row with index 0 is considered to be even).
+	/// </summary>
+	constexpr std::uint32_t EvenRows = 0x0F0F0F0Fu;
+
+	/// <summary>
+	/// Fields of the odd rows.
+	/// </summary>
+	constexpr std::uint32_t OddRows = 0xF0F0F0F0u;
+
+	/// <summary>
+	/// The first fields of each row (the ones in the 0th column for the odd rows).
+	/// </summary>
+	constexpr std::uint32_t FirstInRow = 0x11111111u;
+
+	/// <summary>
+	/// The last fields of each row (the ones in the 7th column for the even rows).
+	/// </summary>
+	constexpr std::uint32_t LastInRow = 0x88888888u;
+
+	/// <summary>
+	/// Fields of the last row (the one where men become kings).
+	/// </summary>
+	constexpr std::uint32_t LastRow = 0xF0000000u;
+
+	std::uint32_t CheckersBitboard::shift(const std::uint32_t mask, const int direction_id)
+	{
+		switch (direction_id)
+		{
+		case 0: return ((mask & EvenRows & ~LastInRow) >> 3) | ((mask & OddRows) >> 4);
+		case 1: return ((mask & EvenRows) << 4) | ((mask & OddRows & ~FirstInRow) << 3);
+		case 2: return ((mask & EvenRows) >> 4) | ((mask & OddRows & ~FirstInRow) >> 5);
+		case 3: return ((mask & EvenRows & ~LastInRow) << 5) | ((mask & OddRows) << 4);
+		default: throw std::exception("Invalid direction");
+		}
+	}
+
+	bool CheckersBitboard::is_backward(const int direction_id)
+	{
+		return direction_id == 0 || direction_id == 2;
+	}
+
+	PiecePosition CheckersBitboard::to_position(const int field_id)
+	{
+		const auto row_id = field_id / FieldsInRow;
+		return { row_id, (field_id % FieldsInRow) * 2 + ((row_id % 2) == 0) };
+	}
+
+	CheckersBitboard::CheckersBitboard(const CheckersState& state)
+	{
+		for (auto field_id = 0; field_id < StateSize; ++field_id)
+		{
+			const auto bit = 1u << field_id;
+
+			switch (state[field_id])
+			{
+			case Piece::Man: _men |= bit;
+				break;
+			case Piece::King: _kings |= bit;
+				break;
+			case Piece::AntiMan:
+			case Piece::AntiKing: _opponents |= bit;
+				break;
+			case Piece::Space: _empty |= bit;
+				break;
+			default: break; // all the other "pieces" just block the fields they occupy
+			}
+		}
+	}
+
+	bool CheckersBitboard::has_captures() const
+	{
+		for (auto direction_id = 0; direction_id < DirectionsCount; ++direction_id)
+		{
+			// fields that men can capture
+			auto reachable = shift(_men, direction_id);
+
+			// kings can approach the fields to capture along the empty ones
+			auto front = shift(_kings, direction_id);
+			while (front != 0)
+			{
+				reachable |= front;
+				front = shift(front & _empty, direction_id);
+			}
+
+			if ((shift(reachable & _opponents, direction_id) & _empty) != 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	void CheckersBitboard::append_capture_chains(const int start_id, const int field_id, const bool is_man,
+		const std::uint32_t empty, const std::uint32_t capturable,
+		std::array<PiecePosition, CheckersMove::MaxCapturesCount>& captures, const int captures_count,
+		CheckersState::MoveList& out_result)
+	{
+		const auto field_bit = 1u << field_id;
+
+		for (auto direction_id = 0; direction_id < DirectionsCount; ++direction_id)
+		{
+			auto target = shift(field_bit, direction_id);
+
+			if (!is_man)
+			{
+				while ((target & empty) != 0)
+					target = shift(target, direction_id);
+			}
+
+			const auto capture_bit = target & capturable;
+
+			if (capture_bit == 0)
+				continue;
+
+			auto landing = shift(capture_bit, direction_id) & empty;
+
+			if (landing == 0)
+				continue;
+
+			// sanity check
+			if (captures_count >= CheckersMove::MaxCapturesCount)
+				throw std::exception("Too many captures");
+
+			captures[captures_count] = to_position(std::countr_zero(capture_bit));
+			const auto next_capturable = capturable & ~capture_bit;
+			const auto start_pos = to_position(start_id);
+
+			do
+			{
+				const auto landing_id = std::countr_zero(landing);
+				out_result.push_back(CheckersMove(start_pos, to_position(landing_id)));
+				out_result.back().captures.assign(captures.begin(), captures.begin() + captures_count + 1);
+
+				// according to the rules, a man that reaches the last row becomes a king and the move is over
+				if (is_man && (landing & LastRow) != 0)
+					break;
+
+				append_capture_chains(start_id, landing_id, is_man, (empty | field_bit) & ~landing,
+					next_capturable, captures, captures_count + 1, out_result);
+
+				landing = is_man ? 0 : shift(landing, direction_id) & empty;
+			} while (landing != 0);
+		}
+	}
+
+	void CheckersBitboard::get_capturing_moves(CheckersState::MoveList& out_result) const
+	{
+		out_result.clear();
+
+		if (!has_captures())
+			return;
+
+		std::array<PiecePosition, CheckersMove::MaxCapturesCount> captures{};
+
+		for (auto pieces = _men | _kings; pieces != 0; pieces &= pieces - 1)
+		{
+			const auto field_id = std::countr_zero(pieces);
+			append_capture_chains(field_id, field_id, (_men & (1u << field_id)) != 0,
+				_empty, _opponents, captures, 0, out_result);
+		}
+	}
+
+	void CheckersBitboard::get_non_capturing_moves(CheckersState::MoveList& out_result) const
+	{
+		out_result.clear();
+
+		for (auto pieces = _men | _kings; pieces != 0; pieces &= pieces - 1)
+		{
+			const auto field_id = std::countr_zero(pieces);
+			const auto is_man = (_men & (1u << field_id)) != 0;
+			const auto start_pos = to_position(field_id);
+
+			for (auto direction_id = 0; direction_id < DirectionsCount; ++direction_id)
+			{
+				if (is_man && is_backward(direction_id))
+					continue; //man can't move backwards
+
+				for (auto target = shift(1u << field_id, direction_id) & _empty; target != 0;
+					target = is_man ? 0 : shift(target, direction_id) & _empty)
+					out_result.push_back(CheckersMove(start_pos, to_position(std::countr_zero(target))));
+			}
+		}
+	}
+
+	void CheckersBitboard::get_moves(CheckersState::MoveList& out_result) const
+	{
+		get_capturing_moves(out_result);
+
+		if (!out_result.empty())
+			return;
+
+		get_non_capturing_moves(out_result);
+	}
+}
@@ -27,7 +27,7 @@ namespace TrainingCell::Checkers
 
 		finish = continuation.finish;
 
-		captures.insert(captures.end(), continuation.captures.begin(), continuation.captures.end());
+		captures.append(continuation.captures.begin(), continuation.captures.end());
 	}
 
 	CheckersMove::CheckersMove(const PiecePosition& start, const PiecePosition& finish) :
@@ -35,7 +35,7 @@ namespace TrainingCell::Checkers
 
 	CheckersMove::CheckersMove(const PiecePosition& start, const PiecePosition& finish,
 		const std::vector<PiecePosition>& captures) :
-		start(start), finish(finish), captures(captures) {}
+		start(start), finish(finish), captures(captures.begin(), captures.end()) {}
 
 	/// <summary>
 	/// Returns next position of a piece that currently is located at the given "prev_piece_pos" and about to capture
@@ -89,7 +89,7 @@ namespace TrainingCell::Checkers
 
 		SubMove final_sub_move{ prev_pos , finish };
 		if (!captures.empty())
-			final_sub_move.capture = *captures.rbegin();
+			final_sub_move.capture = captures.back();
 
 		result.push_back(final_sub_move);
 
@@ -16,8 +16,10 @@
 //SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <algorithm>
+#include <limits>
 #include "../../Headers/Checkers/CheckersState.h"
 #include "../../Headers/Checkers/StateHandle.h"
+#include "../../Headers/Checkers/CheckersBitboard.h"
 
 namespace TrainingCell::Checkers
 {
@@ -158,12 +160,18 @@ namespace TrainingCell::Checkers
 
 	[[nodiscard]] std::vector<int> CheckersState::to_vector() const
 	{
-		std::vector<int> result(size());
-		std::memcpy(result.data(), data(), size() * sizeof(int));
+		std::vector<int> result;
+		to_vector(result);
 
 		return result;
 	}
 
+	void CheckersState::to_vector(std::vector<int>& out_result) const
+	{
+		out_result.resize(size());
+		std::memcpy(out_result.data(), data(), size() * sizeof(int));
+	}
+
 	std::size_t CheckersState::state_size()
 	{
 		return StateSize;
@@ -192,19 +200,24 @@ namespace TrainingCell::Checkers
 		return expand_to_64(get_vector_inverted());
 	}
 
-	std::vector<CheckersMove> CheckersState::get_moves() const
+	CheckersState::MoveList CheckersState::get_moves() const
 	{
-		std::vector<CheckersMove> result;
-		get_moves(*this, result);
+		MoveList result;
+		CheckersBitboard(*this).get_moves(result);
 		return result;
 	}
 
-	bool CheckersState::get_moves(std::vector<CheckersMove>& out_result) const
+	bool CheckersState::get_moves(MoveList& out_result) const
 	{
-		get_moves(*this, out_result);
+		CheckersBitboard(*this).get_moves(out_result);
 		return false; // it is never a draw in checkers.
 	}
 
+	void CheckersState::get_moves_reference(MoveList& out_result) const
+	{
+		get_moves(*this, out_result);
+	}
+
 	CheckersState CheckersState::get_inverted() const
 	{
 		auto result = *this;
@@ -309,11 +322,17 @@ namespace TrainingCell::Checkers
 
 	std::vector<int> CheckersState::get_vector(const CheckersMove& move) const
 	{
-		auto result = to_vector();
-		make_move_internal(move, result.data(), true /*remove captured*/);
+		std::vector<int> result;
+		get_vector(move, result);
 		return result;
 	}
 
+	void CheckersState::get_vector(const CheckersMove& move, std::vector<int>& out_result) const
+	{
+		to_vector(out_result);
+		make_move_internal(move, out_result.data(), true /*remove captured*/);
+	}
+
 	std::vector<int> CheckersState::get_vector_inverted(const CheckersMove& move) const
 	{
 		auto result = get_vector(move);
@@ -336,6 +355,14 @@ namespace TrainingCell::Checkers
 		return std::make_unique<StateHandle>(*this, initialize_recorder);
 	}
 
+	void CheckersState::yield(std::unique_ptr<IState>& state_ptr, const bool initialize_recorder) const
+	{
+		if (const auto handle_ptr = dynamic_cast<StateHandle*>(state_ptr.get()); handle_ptr != nullptr)
+			handle_ptr->reset(*this, initialize_recorder);
+		else
+			state_ptr = yield(initialize_recorder);
+	}
+
 	StateTypeId CheckersState::type()
 	{
 		return StateTypeId::CHECKERS;
@@ -600,7 +627,7 @@ namespace TrainingCell::Checkers
 		return result;
 	}
 
-	void CheckersState::get_capturing_moves(const CheckersState& current_state, std::vector<CheckersMove>& out_result)
+	void CheckersState::get_capturing_moves(const CheckersState& current_state, MoveList& out_result)
 	{
 		out_result.clear();
 
@@ -614,11 +641,11 @@ namespace TrainingCell::Checkers
 			if (moves.empty())
 				continue;
 
-			out_result.insert(out_result.end(), moves.begin(), moves.end());
+			out_result.append(moves.begin(), moves.end());
 		}
 	}
 
-	void CheckersState::get_non_capturing_moves(const CheckersState& current_state, std::vector<CheckersMove>& out_result)
+	void CheckersState::get_non_capturing_moves(const CheckersState& current_state, MoveList& out_result)
 	{
 		out_result.clear();
 
@@ -632,11 +659,11 @@ namespace TrainingCell::Checkers
 			if (moves.empty())
 				continue;
 
-			out_result.insert(out_result.end(), moves.begin(), moves.end());
+			out_result.append(moves.begin(), moves.end());
 		}
 	}
 
-	void CheckersState::get_moves(const CheckersState& current_state, std::vector<CheckersMove>& out_result)
+	void CheckersState::get_moves(const CheckersState& current_state, MoveList& out_result)
 	{
 		get_capturing_moves(current_state, out_result);
 
@@ -17,6 +17,7 @@
 
 #include "../../Headers/Chess/AttackController.h"
 #include "../../Headers/Chess/PieceController.h"
+#include "../../Headers/Chess/PosController.h"
 
 namespace TrainingCell::Chess
 {
@@ -32,37 +33,50 @@ namespace TrainingCell::Chess
 		return div_res.rem == 0;
 	}
 
-	bool AttackController::Direction::can_reach(const PiecePosition& start, const PiecePosition& end, int& out_param) const
+	AttackController::AttackController()
 	{
-        if (dir.row == 0 && dir.col == 0)
-            throw std::exception("Undefined direction");
+		for (const auto& dir : _queen_directions)
+			_ray_vectors[dir.ray_id] = dir.dir;
 
-		if (!is_long_range())
-		{
-			out_param = 1;
-			return start + dir == end;
-		}
+		for (const auto& dir : _knight_directions)
+			_ray_vectors[dir.ray_id] = dir.dir;
 
-		// The implementation below assumes that the current direction vector
-		// can be represented in one of the following forms: (1, 1), (-1, 1), (1, -1), (-1, -1)
+		for (auto field_id = 0; field_id < Checkerboard::FieldsCount; ++field_id)
+		{
+			const auto field_pos = PosController::from_linear(field_id);
 
-        if (dir.row == 0)
-        {
-			if (start.row == end.row)
+			for (auto ray_id = 0; ray_id < RaysPerFieldCount; ++ray_id)
 			{
-				out_param = static_cast<int>((end.col - start.col) * dir.col);
-				return true;
+				auto& ray = _rays[field_id][ray_id];
+				auto pos = field_pos + _ray_vectors[ray_id];
+
+				while (pos.is_valid() && ray.length < static_cast<int>(ray.field_ids.size()))
+				{
+					const auto ray_field_id = static_cast<int>(PosController::to_linear(pos));
+					ray.field_ids[ray.length++] = ray_field_id;
+					ray.fields_mask |= 1ull << ray_field_id;
+					pos += _ray_vectors[ray_id];
+				}
 			}
+		}
 
-			return false;
-        }
-
-		out_param = static_cast<int>((end.row - start.row) * dir.row);
+		for (auto encoded_dirs = 0; encoded_dirs <= LongRangeDirGroupMask; ++encoded_dirs)
+			for (const auto& dir : _queen_directions)
+			{
+				if ((dir.token & encoded_dirs) != 0)
+					_long_range_directions[encoded_dirs].push_back(dir);
+			}
+	}
 
-        if (dir.col == 0)
-			return start.col == end.col;
+	const AttackController& AttackController::instance()
+	{
+		static const AttackController controller;
+		return controller;
+	}
 
-		return out_param == static_cast<int>((end.col - start.col) * dir.col);
+	const AttackController::Ray& AttackController::get_ray(const int field_id, const int ray_id, const bool opposite) const
+	{
+		return _rays[field_id][opposite ? ray_id ^ 1 : ray_id];
 	}
 
 	const std::vector<AttackController::Direction>& AttackController::get_attack_directions(const int piece_rank_token) const
@@ -90,20 +104,9 @@ namespace TrainingCell::Chess
 		return _pawn_directions;
 	}
 
-	std::vector<AttackController::Direction> AttackController::decode_long_range_attack_directions(const int encoded_attack_directions) const
+	const std::vector<AttackController::Direction>& AttackController::decode_long_range_attack_directions(const int encoded_attack_directions) const
 	{
-		std::vector<Direction> result;
-
-		if ((encoded_attack_directions & LongRangeDirGroupMask) == 0)
-			return result;
-
-		for (const auto& dir : _queen_directions)
-		{
-			if ((dir.token & encoded_attack_directions) != 0)
-				result.push_back(dir);
-		}
-
-		return result;
+		return _long_range_directions[encoded_attack_directions & LongRangeDirGroupMask];
 	}
 
 	int AttackController::compress_attack_directions(const int encoded_attack_directions)
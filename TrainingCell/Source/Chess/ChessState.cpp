@@ -23,22 +23,22 @@
 
 namespace TrainingCell::Chess
 {
-	std::vector<ChessMove> ChessState::get_moves() const
+	ChessState::MoveList ChessState::get_moves() const
 	{
-		std::vector<ChessMove> result;
+		MoveList result;
 		get_moves(result);
 		return result;
 	}
 
-	bool ChessState::get_moves(std::vector<ChessMove>& out_result) const
+	bool ChessState::get_moves(MoveList& out_result) const
 	{
 		out_result.clear();
 
 		const auto king_field_id = locate_king();
-		const auto king_pos = PosController::from_linear(king_field_id);
-
 		append_king_moves(king_field_id, out_result);
 
+		const auto move_constraints = get_move_constraints(king_field_id);
+
 		int piece_score_sum = 0;
 		int alive_pieces_cnt = 0;
 
@@ -51,15 +51,20 @@ namespace TrainingCell::Chess
 			if (!is_ally(field_id) || king_field_id == field_id)
 				continue;
 
+			const auto allowed_fields = move_constraints.get_allowed_fields(field_id);
+
+			if (allowed_fields == 0)
+				continue;
+
 			if (is_pawn(field_id))
 			{
-				append_pawn_moves(field_id, out_result, king_pos);
+				append_pawn_moves(field_id, out_result, allowed_fields);
 				continue;
 			}
 
 			const auto& attack_directions =
-				_attack_controller.get_attack_directions(_data[field_id].piece);
-			append_moves(field_id, out_result, attack_directions, king_pos);
+				attack_controller().get_attack_directions(_data[field_id].piece);
+			append_moves(field_id, out_result, attack_directions, allowed_fields);
 		}
 
 		piece_score_sum -= 2 * PieceController::King;
@@ -95,22 +100,27 @@ namespace TrainingCell::Chess
 	}
 
 	std::vector<int> ChessState::get_vector(const ChessMove& move) const
+	{
+		std::vector<int> result;
+		get_vector(move, result);
+		return result;
+	}
+
+	void ChessState::get_vector(const ChessMove& move, std::vector<int>& out_result) const
 	{
 		// A sanity check
 		if (!is_ally(move.start_field_id) || is_ally(move.finish_field_id))
 			throw std::exception("Invalid move");
 
-		auto result = to_vector();
+		to_vector(out_result);
 
 		ChessMove second_component{};
 		const auto compound_move = is_compound_move(move, second_component);
 
-		make_move(result, move);
+		make_move(out_result, move);
 
 		if (compound_move)
-			make_move(result, second_component);
-
-		return result;
+			make_move(out_result, second_component);
 	}
 
 	void ChessState::invert()
@@ -186,33 +196,37 @@ namespace TrainingCell::Chess
 		if (!start.is_valid() || !finish.is_valid())
 			throw std::exception("Invalid input positions");
 
-		auto& start_field = _data[PosController::to_linear(start)];
+		const auto start_field_id = static_cast<int>(PosController::to_linear(start));
+		auto& start_field = _data[start_field_id];
 
 		if (PieceController::is_rival_piece(start_field.piece))
 			throw std::exception("Only ally piece can be moved");
 
-		auto& finish_field = _data[PosController::to_linear(finish)];
+		const auto finish_field_id = static_cast<int>(PosController::to_linear(finish));
+		auto& finish_field = _data[finish_field_id];
 
 		if (PieceController::is_ally_piece(finish_field.piece))
 			throw std::exception("Can't capture an ally");
 
-		commit_attack(_attack_controller.decode_long_range_attack_directions(start_field.rival_attack), start, true /*rival*/);
-		withdraw_attack(_attack_controller.get_attack_directions(start_field.piece), start, false /*rival*/);
-		commit_attack(_attack_controller.decode_long_range_attack_directions(start_field.ally_attack), start, false /*rival*/);
+		const auto& controller = attack_controller();
+
+		commit_attack(controller.decode_long_range_attack_directions(start_field.rival_attack), start_field_id, true /*rival*/);
+		withdraw_attack(controller.get_attack_directions(start_field.piece), start_field_id, false /*rival*/);
+		commit_attack(controller.decode_long_range_attack_directions(start_field.ally_attack), start_field_id, false /*rival*/);
 
 		const auto moving_piece = move.get_final_piece_rank(start_field.piece);
 		start_field.piece = PieceController::Space;
 
-		const auto rival_attacks_to_withdraw = PieceController::is_rival_piece(finish_field.piece) ?
-			_attack_controller.get_attack_directions(finish_field.piece) :
-			_attack_controller.decode_long_range_attack_directions(finish_field.rival_attack);
+		const auto& rival_attacks_to_withdraw = PieceController::is_rival_piece(finish_field.piece) ?
+			controller.get_attack_directions(finish_field.piece) :
+			controller.decode_long_range_attack_directions(finish_field.rival_attack);
 
-		withdraw_attack(rival_attacks_to_withdraw, finish, true /*rival*/);
+		withdraw_attack(rival_attacks_to_withdraw, finish_field_id, true /*rival*/);
 
 		if (PieceController::is_space(finish_field.piece))
-			withdraw_attack(_attack_controller.decode_long_range_attack_directions(finish_field.ally_attack), finish, false /*rival*/);
+			withdraw_attack(controller.decode_long_range_attack_directions(finish_field.ally_attack), finish_field_id, false /*rival*/);
 
-		commit_attack(_attack_controller.get_attack_directions(moving_piece), finish, false /*rival*/);
+		commit_attack(controller.get_attack_directions(moving_piece), finish_field_id, false /*rival*/);
 
 		finish_field.piece = PieceController::extract_min_piece_rank(moving_piece);
 	}
@@ -259,6 +273,17 @@ namespace TrainingCell::Chess
 	template std::vector<int> ChessState::to_vector<true>() const;
 	template std::vector<int> ChessState::to_vector<false>() const;
 
+	void ChessState::to_vector(std::vector<int>& out_result) const
+	{
+		out_result.resize(_data.size());
+
+		std::ranges::transform(_data, out_result.begin(),
+			[](const auto& f)
+			{
+				return f.template to_int<false>();
+			});
+	}
+
 	ChessState::ChessState(const std::vector<int>& board_state, const bool inverted)
 	{
 		_is_inverted = inverted;
@@ -294,6 +319,14 @@ namespace TrainingCell::Chess
 		return std::make_unique<StateHandle>(*this, initialize_recorder);
 	}
 
+	void ChessState::yield(std::unique_ptr<IState>& state_ptr, const bool initialize_recorder) const
+	{
+		if (const auto handle_ptr = dynamic_cast<StateHandle*>(state_ptr.get()); handle_ptr != nullptr)
+			handle_ptr->reset(*this, initialize_recorder);
+		else
+			state_ptr = yield(initialize_recorder);
+	}
+
 	StateTypeId ChessState::type()
 	{
 		return StateTypeId::CHESS;
@@ -357,125 +390,115 @@ namespace TrainingCell::Chess
 		return !(*this == other_field);
 	}
 
+	const AttackController& ChessState::attack_controller()
+	{
+		return AttackController::instance();
+	}
+
+	template <class Op>
+	void ChessState::process_attack(const std::vector<AttackController::Direction>& attack_directions,
+		const int field_id, const bool negate_dir, const Op& operation)
+	{
+		const auto& controller = attack_controller();
+
+		for (const auto& attack : attack_directions)
+		{
+			const auto& ray = controller.get_ray(field_id, attack.ray_id, negate_dir);
+
+			for (auto step_id = 0; step_id < ray.length; ++step_id)
+			{
+				auto& field = _data[ray.field_ids[step_id]];
+				operation(field, attack.token);
+
+				if (!attack.is_long_range() || !PieceController::is_space(field.piece))
+					break;
+			}
+		}
+	}
+
 	void ChessState::commit_attack(const std::vector<AttackController::Direction>& attack_directions,
-	                               const PiecePosition& position, const bool rival)
+	                               const int field_id, const bool rival)
 	{
-		process_attack(attack_directions, position, rival, [rival](Field& field, const int attack)
+		process_attack(attack_directions, field_id, rival, [rival](Field& field, const int attack)
 			{
 				field.add_attack_flag(attack, rival);
 			});
 	}
 
 	void ChessState::withdraw_attack(const std::vector<AttackController::Direction>& attack_directions,
-	                            const PiecePosition& position, const bool rival)
+	                            const int field_id, const bool rival)
 	{
-		process_attack(attack_directions, position, rival, [rival](Field& field, const int attack)
+		process_attack(attack_directions, field_id, rival, [rival](Field& field, const int attack)
 			{
 				field.remove_attack_flag(attack, rival);
 			});
 	}
 
-	void ChessState::process_attack(const std::vector<AttackController::Direction>& attack_directions,
-		const PiecePosition& position, const bool negate_dir, const std::function<void(Field&, const int)>& operation)
+	std::uint64_t ChessState::MoveConstraints::get_allowed_fields(const int field_id) const
 	{
-		for (const auto& attack : attack_directions)
-		{
-			const auto dir = negate_dir ? -attack.dir : attack.dir;
-
-			auto next_field_pos = position + dir;
-
-			if (!next_field_pos.is_valid())
-				continue;
-
-			auto next_field_id = PosController::to_linear(next_field_pos);
-			operation(_data[next_field_id], attack.token);
-
-			if (attack.is_long_range())
-			{
-				while (PieceController::is_space(_data[next_field_id].piece) && (next_field_pos += dir).is_valid())
-				{
-					next_field_id = PosController::to_linear(next_field_pos);
-					operation(_data[next_field_id], attack.token);
-				}
-			}
-		}
+		const auto field_bit = 1ull << field_id;
+		return (pinned_fields & field_bit) != 0 ? evasion_fields & pin_lines[field_id] : evasion_fields;
 	}
 
-	bool ChessState::is_king_threatened_after_move(const PiecePosition& move_start_pos,
-	                                               const PiecePosition& move_finish_pos,
-	                                               const PiecePosition& king_field_pos) const
+	ChessState::MoveConstraints ChessState::get_move_constraints(const int king_field_id) const
 	{
-		if (!move_start_pos.is_valid() || !move_finish_pos.is_valid() || !king_field_pos.is_valid())
-			throw std::exception("Invalid input data");
-
-		const auto& start_field = _data[PosController::to_linear(move_start_pos)];
-		const auto& finish_field = _data[PosController::to_linear(move_finish_pos)];
-
-		if (!PieceController::is_ally_piece(start_field.piece) || PieceController::is_ally_piece(finish_field.piece))
-			throw std::exception("Impossible move");
-
-		auto result = _data[PosController::to_linear(king_field_pos)].rival_attack;
-
-		const auto attack_directions_to_commit =
-			_attack_controller.decode_long_range_attack_directions(start_field.rival_attack);
-
-		const auto induced_attack = get_rival_attack_on_field(attack_directions_to_commit, move_start_pos, king_field_pos);
+		const auto& controller = attack_controller();
+		const auto king_rival_attack = _data[king_field_id].rival_attack;
 
-		if (induced_attack != 0 && result != 0)
-			return true; //the king is already under the attack and the current piece can't cover it since is is already covering it from another attack
+		MoveConstraints result{ ~0ull };
+		auto checking_pieces_count = 0;
 
-		if (induced_attack == 0 && result == 0)
-			return false; //the lifting of the current piece will not result in any threat
-
-		if (induced_attack != 0)
+		// Walk along each "straight" line starting from the king to find the first piece on it.
+		// It is either a rival piece that gives check (in which case the corresponding long-range attack
+		// token is present on the king's field) or an ally piece that might be pinned (in which case the
+		// same long-range attack token is present on the field of the ally piece).
+		for (const auto& dir : controller.get_attack_directions(PieceController::Queen))
 		{
-			const auto covered_attack = _attack_controller.decode_long_range_attack_directions(induced_attack);
-
-			if (covered_attack.size() != 1)
-				throw std::exception("One piece can't cover more than one attack direction with respect to King position");
-
-			const auto covered_attack_dir = covered_attack[0].dir;
-			const auto move_dir = move_finish_pos - move_start_pos;
-
-			// In this particular case the current piece is allowed to move only along the direction of the attack it is covering.
-			return move_dir.col * covered_attack_dir.row != move_dir.row * covered_attack_dir.col;
-		}
+			const auto& ray = controller.get_ray(king_field_id, dir.ray_id);
+			auto line_fields = 0ull;
+			auto step_id = 0;
 
-		const auto attack_directions_to_withdraw = PieceController::is_rival_piece(finish_field.piece) ?
-			_attack_controller.get_attack_directions(finish_field.piece) :
-			_attack_controller.decode_long_range_attack_directions(finish_field.rival_attack);
+			while (step_id < ray.length && is_space(ray.field_ids[step_id]))
+				line_fields |= 1ull << ray.field_ids[step_id++];
 
-		result &= ~get_rival_attack_on_field(attack_directions_to_withdraw, move_finish_pos, king_field_pos);
+			if (step_id == ray.length)
+				continue;
 
+			const auto piece_field_id = ray.field_ids[step_id];
+			line_fields |= 1ull << piece_field_id;
 
-		return result;
-	}
+			if ((king_rival_attack & dir.token) != 0)
+			{
+				result.evasion_fields = line_fields; // to block the attack or to capture the attacking piece
+				++checking_pieces_count;
+			}
+			else if (is_ally(piece_field_id) && (_data[piece_field_id].rival_attack & dir.token) != 0)
+			{
+				result.pinned_fields |= 1ull << piece_field_id;
+				result.pin_lines[piece_field_id] = ray.fields_mask;
+			}
+		}
 
-	int ChessState::get_rival_attack_on_field(const std::vector<AttackController::Direction>& rival_attack_directions,
-		const PiecePosition& source_position, const PiecePosition& focus_field_pos) const
-	{
-		for (const auto& attack_dir : rival_attack_directions)
+		// Short-range attacks (pawns and knights) can only be evaded by capturing the attacking piece.
+		const auto register_short_range_checks = [&](const std::vector<AttackController::Direction>& directions)
 		{
-			int steps_count = -1;
-			const auto neg_attack_dir = AttackController::Direction{ -attack_dir.dir, attack_dir.token };
-			if (neg_attack_dir.can_reach(source_position, focus_field_pos, steps_count) && steps_count > 0)
+			for (const auto& dir : directions)
 			{
-				if (steps_count == 1)
-					return neg_attack_dir.token;
+				if ((king_rival_attack & dir.token) == 0)
+					continue;
 
-				auto next_pos = source_position + neg_attack_dir.dir;
+				result.evasion_fields = 1ull << controller.get_ray(king_field_id, dir.ray_id).field_ids[0];
+				++checking_pieces_count;
+			}
+		};
 
-				while (PieceController::is_space(_data[PosController::to_linear(next_pos)].piece) && next_pos != focus_field_pos)
-					next_pos += neg_attack_dir.dir;
+		register_short_range_checks(controller.get_king_attack_directions());
+		register_short_range_checks(controller.get_attack_directions(PieceController::Knight));
 
-				if (next_pos == focus_field_pos)
-					return neg_attack_dir.token;
+		if (checking_pieces_count > 1)
+			result.evasion_fields = 0; // only the king can move in case of a double check
 
-				return 0; // we expect that only one attack direction from the given collection can in principle point towards the focus field;
-			}
-		}
-
-		return 0;
+		return result;
 	}
 
 	void ChessState::build(const std::vector<int>& board_state)
@@ -490,43 +513,15 @@ namespace TrainingCell::Chess
 			if (PieceController::is_space(field_data_ref.piece))
 				continue;
 
-			const auto attack_directions =
-				_attack_controller.get_attack_directions(field_data_ref.piece);
+			const auto& attack_directions =
+				attack_controller().get_attack_directions(field_data_ref.piece);
 			const auto rival_attack = PieceController::is_rival_piece(field_data_ref.piece);
-			const auto current_pos = PosController::from_linear(field_id);
 
-			commit_attack(attack_directions, current_pos, rival_attack);
+			commit_attack(attack_directions, field_id, rival_attack);
 		}
 	}
 
-	/// <summary>
-	/// Returns only those directions from "source" collection that are not
-	/// opposite to any of the directions in the "dirs_to_check" collection.
-	/// This is equivalent to removing "coinciding" directions, provided that
-	/// collection "dirs_to_check" represent attack directions of a rival piece.
-	/// </summary>
-	std::vector<AttackController::Direction> remove_same_directions(const std::vector<AttackController::Direction>& source,
-		const std::vector<AttackController::Direction>& dirs_to_check)
-	{
-		if (dirs_to_check.empty())
-			return source;
-
-		std::vector<AttackController::Direction> result{};
-
-		for (const auto& source_dir : source)
-		{
-			const auto op_source_dir = -source_dir.dir;
-			if (std::ranges::all_of(dirs_to_check, [&op_source_dir](const auto& check_dir)
-			{
-				return check_dir.dir != op_source_dir;
-			}))
-				result.push_back(source_dir);
-		}
-
-		return result;
-	}
-
-	void ChessState::append_king_moves(const int king_field_id, std::vector<ChessMove>& moves) const
+	void ChessState::append_king_moves(const int king_field_id, MoveList& moves) const
 	{
 		const auto& king_field = _data[king_field_id];
 
@@ -534,19 +529,24 @@ namespace TrainingCell::Chess
 		if (!PieceController::is_king(king_field.piece))
 			throw std::exception("There is not 'King' on the start field");
 
-		const auto start_pos = PosController::from_linear(king_field_id);
+		const auto& controller = attack_controller();
 
-		const auto is_check = is_threatened(king_field_id);
-		const auto& attack_directions = 
-			is_check ? remove_same_directions(_attack_controller.get_king_attack_directions(),
-			_attack_controller.decode_long_range_attack_directions(king_field.rival_attack)) :
-			_attack_controller.get_king_attack_directions();
+		// The king can't step back along the line of a long-range attack it is under
+		// (the field behind the king is "shadowed" by the king itself and thus is not marked as attacked).
+		// Bits of the mask below correspond to the IDs of the rays that are opposite to the rival attack directions.
+		auto forbidden_rays_mask = 0;
+		for (const auto& rival_dir : controller.decode_long_range_attack_directions(king_field.rival_attack))
+			forbidden_rays_mask |= 1 << (rival_dir.ray_id ^ 1);
 
-		for (const auto& attack_dir : attack_directions)
+		for (const auto& attack_dir : controller.get_king_attack_directions())
 		{
-			const auto finish_field_pos = start_pos + attack_dir.dir;
-			const auto finish_field_id = PosController::to_linear(finish_field_pos);
-			if (!finish_field_pos.is_valid() || is_threatened(finish_field_id) || is_ally(finish_field_id))
+			const auto& ray = controller.get_ray(king_field_id, attack_dir.ray_id);
+
+			if (ray.length == 0 || (forbidden_rays_mask & (1 << attack_dir.ray_id)) != 0)
+				continue;
+
+			const auto finish_field_id = ray.field_ids[0];
+			if (is_threatened(finish_field_id) || is_ally(finish_field_id))
 				continue;
 
 			moves.push_back(ChessMove(king_field_id, static_cast<int>(finish_field_id),
@@ -579,8 +579,27 @@ namespace TrainingCell::Chess
 		}
 	}
 
+	static const std::vector PromotionOptions{
+		PieceController::Queen,
+		PieceController::Bishop,
+		PieceController::Knight,
+		PieceController::Rook };
+
+	void ChessState::append_pawn_move(MoveList& moves, const int start_field_id, const int finish_field_id,
+		const bool captures, const bool promotion)
+	{
+		if (!promotion)
+		{
+			moves.push_back(ChessMove(start_field_id, finish_field_id, captures));
+			return;
+		}
+
+		for (const auto promo_option : PromotionOptions)
+			moves.push_back(ChessMove(start_field_id, finish_field_id, captures, promo_option));
+	}
+
 	void ChessState::append_pawn_moves_basic(const int pawn_field_id,
-		std::vector<ChessMove>& moves, const PiecePosition& king_pos) const
+		MoveList& moves, const std::uint64_t allowed_fields, const bool promotion) const
 	{
 		const auto& pawn_field = _data[pawn_field_id];
 
@@ -588,7 +607,7 @@ namespace TrainingCell::Chess
 		if (!PieceController::is_pawn(pawn_field.piece))
 			throw std::exception("There is not 'Pawn'");
 
-		const auto& attack_directions = _attack_controller.get_pawn_attack_directions();
+		const auto& attack_directions = attack_controller().get_pawn_attack_directions();
 
 		const auto start_pos = PosController::from_linear(pawn_field_id);
 
@@ -600,8 +619,8 @@ namespace TrainingCell::Chess
 				continue;
 
 			const auto finish_pos_lin = PosController::to_linear(finish_pos);
-			if (is_rival(finish_pos_lin) && !is_king_threatened_after_move(start_pos, finish_pos, king_pos))
-				moves.push_back(ChessMove(pawn_field_id, static_cast<int>(finish_pos_lin), true));
+			if (is_rival(finish_pos_lin) && (allowed_fields & (1ull << finish_pos_lin)) != 0)
+				append_pawn_move(moves, pawn_field_id, static_cast<int>(finish_pos_lin), true, promotion);
 		}
 
 		// Now handle "pawn-specific" moves
@@ -619,78 +638,47 @@ namespace TrainingCell::Chess
 				if (!is_space(next_field_id))
 					return;
 
-				if (!is_king_threatened_after_move(start_pos, finish_pos, king_pos))
-					moves.push_back(ChessMove(pawn_field_id,static_cast<int>(next_field_id), false));
+				if ((allowed_fields & (1ull << next_field_id)) != 0)
+					append_pawn_move(moves, pawn_field_id, static_cast<int>(next_field_id), false, promotion);
 			}
 			else
 				return;
 		}
 	}
 
-	static const std::vector PromotionOptions{
-		PieceController::Queen,
-		PieceController::Bishop,
-		PieceController::Knight,
-		PieceController::Rook };
-
-	void ChessState::append_pawn_moves(const int pawn_field_id, std::vector<ChessMove>& moves,
-		const PiecePosition& king_pos) const
+	void ChessState::append_pawn_moves(const int pawn_field_id, MoveList& moves,
+		const std::uint64_t allowed_fields) const
 	{
 		const auto start_pos = PosController::from_linear(pawn_field_id);
-
-		if (start_pos.row != (Checkerboard::Rows - 2))
-		{
-			append_pawn_moves_basic(pawn_field_id, moves, king_pos);
-			return;
-		}
-
-		std::vector<ChessMove> temp_moves;
-		append_pawn_moves_basic(pawn_field_id, temp_moves, king_pos);
-
-		for (const auto& temp_move : temp_moves)
-			for (const auto promo_option : PromotionOptions)
-				moves.push_back(ChessMove(temp_move.start_field_id, temp_move.finish_field_id, temp_move.is_capturing(), promo_option));
+		append_pawn_moves_basic(pawn_field_id, moves, allowed_fields, start_pos.row == (Checkerboard::Rows - 2));
 	}
 
-	void ChessState::append_moves(const int start_field_id, std::vector<ChessMove>& moves,
-	                              const std::vector<AttackController::Direction>& attack_directions, const PiecePosition& king_pos) const
+	void ChessState::append_moves(const int start_field_id, MoveList& moves,
+	                              const std::vector<AttackController::Direction>& attack_directions, const std::uint64_t allowed_fields) const
 	{
-		const auto start_pos = PosController::from_linear(start_field_id);
+		const auto& controller = attack_controller();
 
 		for (const auto& attack_dir : attack_directions)
 		{
-			auto finish_pos = start_pos + attack_dir.dir;
-
-			if (attack_dir.is_long_range())
-				while (validate_and_append_move(start_pos, finish_pos, moves, king_pos))
-				{
-					finish_pos += attack_dir.dir;
-				}
-			else
-				validate_and_append_move(start_pos, finish_pos, moves, king_pos);
-		}
-	}
-
-	bool ChessState::validate_and_append_move(const PiecePosition& start_pos, const PiecePosition& finish_pos,
-		std::vector<ChessMove>& moves, const PiecePosition& king_pos) const
-	{
-		if (!finish_pos.is_valid())
-			return false; // we are outside the board
+			const auto& ray = controller.get_ray(start_field_id, attack_dir.ray_id);
+			const auto steps_count = attack_dir.is_long_range() ? ray.length : std::min(ray.length, 1);
 
-		const auto finish_field_id = PosController::to_linear(finish_pos);
-		if (is_ally(finish_field_id))
-			return false; // we are stopped by the "ally" piece
+			for (auto step_id = 0; step_id < steps_count; ++step_id)
+			{
+				const auto finish_field_id = ray.field_ids[step_id];
 
-		// TODO: the line below can be optimized since in some cases there is no sence to explore moves along the current direction
-		if (is_king_threatened_after_move(start_pos, finish_pos, king_pos))
-			return true; // although this move results in "check" it still makes sense to try to move in the same direction (if possible)
+				if (is_ally(finish_field_id))
+					break; // we are stopped by the "ally" piece
 
-		moves.push_back(ChessMove(static_cast<int>(PosController::to_linear(start_pos)),
-			static_cast<int>(finish_field_id), is_rival(finish_field_id)));
+				if ((allowed_fields & (1ull << finish_field_id)) != 0)
+					moves.push_back(ChessMove(start_field_id, finish_field_id, is_rival(finish_field_id)));
 
-		// if it is a "capture move", we can't continue moving in the same
-		// direction (as we would otherwise do in case of long-range moves).
-		return !is_rival(finish_field_id); 
+				// if it is a "capture move", we can't continue moving in the same
+				// direction (as we would otherwise do in case of long-range moves).
+				if (is_rival(finish_field_id))
+					break;
+			}
+		}
 	}
 
 	bool ChessState::is_ally(const long long field_id) const
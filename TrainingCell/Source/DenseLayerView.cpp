@@ -0,0 +1,55 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/DenseLayerView.h"
+#include "../../DeepLearning/DeepLearning/NeuralNet/NLayer.h"
+#include <algorithm>
+
+namespace TrainingCell
+{
+	void DenseLayerView::activate(DeepLearning::Real* values, const int count) const
+	{
+		if (func_id == DeepLearning::ActivationFunctionId::LINEAR)
+			return;
+
+		std::transform(values, values + count, values,
+			[](const auto x) { return std::max(x, static_cast<DeepLearning::Real>(0)); });
+	}
+
+	void DenseLayerView::extract(const DeepLearning::Net<DeepLearning::CpuDC>& net, std::vector<DenseLayerView>& out_layers)
+	{
+		out_layers.clear();
+
+		for (auto layer_id = 0ull; layer_id < net.layers_count(); ++layer_id)
+		{
+			const auto layer_ptr = dynamic_cast<const DeepLearning::NLayer<DeepLearning::CpuDC>*>(&net[layer_id]);
+
+			if (layer_ptr == nullptr)
+				throw std::exception("Only fully connected layers are supported.");
+
+			const auto func_id = layer_ptr->get_func_id();
+
+			if (func_id != DeepLearning::ActivationFunctionId::RELU &&
+				func_id != DeepLearning::ActivationFunctionId::LINEAR)
+				throw std::exception("Unsupported activation function.");
+
+			out_layers.push_back({ layer_ptr->weights().begin(), layer_ptr->biases().begin(),
+				static_cast<int>(layer_ptr->in_size().coord_prod()),
+				static_cast<int>(layer_ptr->out_size().coord_prod()), func_id });
+		}
+	}
+}
@@ -0,0 +1,119 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/EligibilityTracePool.h"
+#include <algorithm>
+
+namespace TrainingCell
+{
+	thread_local EligibilityTracePool EligibilityTracePool::_thread_pool{};
+	thread_local bool EligibilityTracePool::_thread_pool_destroyed{};
+
+	std::size_t EligibilityTracePool::calc_size(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces)
+	{
+		std::size_t result = 0;
+
+		for (const auto& layer_traces : traces)
+		{
+			result += layer_traces.Biases_grad.size();
+
+			for (const auto& weight_traces : layer_traces.Weights_grad)
+				result += weight_traces.size();
+		}
+
+		return result * sizeof(DeepLearning::Real);
+	}
+
+	void EligibilityTracePool::fill_zero(std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces)
+	{
+		for (auto& layer_traces : traces)
+		{
+			std::fill_n(layer_traces.Biases_grad.begin(), layer_traces.Biases_grad.size(), static_cast<DeepLearning::Real>(0));
+
+			for (auto& weight_traces : layer_traces.Weights_grad)
+				std::fill_n(weight_traces.begin(), weight_traces.size(), static_cast<DeepLearning::Real>(0));
+		}
+	}
+
+	EligibilityTracePool::~EligibilityTracePool()
+	{
+		_thread_pool_destroyed = true;
+	}
+
+	bool EligibilityTracePool::acquire(const INet& net, std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& out_traces)
+	{
+		release(out_traces);
+
+		if (_thread_pool_destroyed)
+		{
+			net.allocate(out_traces, /*assign zero*/ true);
+			return true;
+		}
+
+		auto& free_traces = _thread_pool._free_traces;
+		const auto item_it = std::ranges::find_if(free_traces,
+			[&net](const auto& traces) { return net.is_compatible(traces); });
+
+		if (item_it == free_traces.end())
+		{
+			net.allocate(out_traces, /*assign zero*/ true);
+			return true;
+		}
+
+		out_traces = std::move(*item_it);
+		free_traces.erase(item_it);
+		_thread_pool._free_size -= calc_size(out_traces);
+		fill_zero(out_traces);
+
+		return false;
+	}
+
+	void EligibilityTracePool::release(std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces)
+	{
+		if (!traces.empty() && !_thread_pool_destroyed)
+		{
+			const auto size = calc_size(traces);
+
+			if (_thread_pool._free_traces.size() < MaxFreeCount && _thread_pool._free_size + size <= MaxFreeSize)
+			{
+				_thread_pool._free_traces.push_back(std::move(traces));
+				_thread_pool._free_size += size;
+			}
+		}
+
+		traces.clear();
+	}
+
+	void EligibilityTracePool::clear()
+	{
+		if (_thread_pool_destroyed)
+			return;
+
+		_thread_pool._free_traces = std::vector<std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>>();
+		_thread_pool._free_size = 0;
+	}
+
+	std::size_t EligibilityTracePool::get_free_count()
+	{
+		return _thread_pool_destroyed ? 0 : _thread_pool._free_traces.size();
+	}
+
+	std::size_t EligibilityTracePool::get_free_size()
+	{
+		return _thread_pool_destroyed ? 0 : _thread_pool._free_size;
+	}
+}
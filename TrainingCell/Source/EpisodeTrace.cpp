@@ -0,0 +1,131 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "../Headers/EpisodeTrace.h"
+
+namespace TrainingCell
+{
+	void EpisodeTrace::validate_move_id(const int move_id)
+	{
+		if (move_id != 0)
+			throw std::exception("Invalid move id");
+	}
+
+	void EpisodeTrace::reset(const IMinimalStateReadonly& origin)
+	{
+		_origin_ptr = &origin;
+		_plies_count = 0;
+		_current_ply_id = 0;
+	}
+
+	void EpisodeTrace::add_ply(const IStateReadOnly& state, const int move_id)
+	{
+		if (static_cast<int>(_states.size()) <= _plies_count)
+		{
+			_states.resize(_plies_count + 1);
+			_after_states.resize(_plies_count + 1);
+			_capture_flags.resize(_plies_count + 1);
+			_inverted_flags.resize(_plies_count + 1);
+		}
+
+		state.evaluate(_states[_plies_count]);
+		state.evaluate(move_id, _after_states[_plies_count]);
+		_capture_flags[_plies_count] = state.is_capture_action(move_id);
+		_inverted_flags[_plies_count] = state.is_inverted();
+		++_plies_count;
+	}
+
+	int EpisodeTrace::get_plies_count() const
+	{
+		return _plies_count;
+	}
+
+	void EpisodeTrace::set_current_ply(const int ply_id)
+	{
+		if (ply_id < 0 || ply_id >= _plies_count)
+			throw std::exception("Invalid ply id");
+
+		_current_ply_id = ply_id;
+	}
+
+	int EpisodeTrace::get_moves_count() const
+	{
+		return 1;
+	}
+
+	std::vector<int> EpisodeTrace::evaluate(const int move_id) const
+	{
+		validate_move_id(move_id);
+		return _after_states[_current_ply_id];
+	}
+
+	void EpisodeTrace::evaluate(const int move_id, std::vector<int>& out_afterstate) const
+	{
+		validate_move_id(move_id);
+		out_afterstate.assign(_after_states[_current_ply_id].begin(), _after_states[_current_ply_id].end());
+	}
+
+	std::vector<int> EpisodeTrace::evaluate() const
+	{
+		return _states[_current_ply_id];
+	}
+
+	void EpisodeTrace::evaluate(std::vector<int>& out_state) const
+	{
+		out_state.assign(_states[_current_ply_id].begin(), _states[_current_ply_id].end());
+	}
+
+	double EpisodeTrace::calc_reward(const std::vector<int>& prev_state, const std::vector<int>& next_state) const
+	{
+		return _origin_ptr->calc_reward(prev_state, next_state);
+	}
+
+	const IStateSeed& EpisodeTrace::current_state_seed() const
+	{
+		throw std::exception("Episode trace does not provide state seeds");
+	}
+
+	const std::vector<Move> EpisodeTrace::get_all_moves() const
+	{
+		throw std::exception("Not supported");
+	}
+
+	std::vector<int> EpisodeTrace::evaluate_ui() const
+	{
+		throw std::exception("Not supported");
+	}
+
+	std::vector<int> EpisodeTrace::evaluate_ui_inverted() const
+	{
+		throw std::exception("Not supported");
+	}
+
+	bool EpisodeTrace::is_capture_action(const int action_id) const
+	{
+		validate_move_id(action_id);
+		return _capture_flags[_current_ply_id];
+	}
+
+	bool EpisodeTrace::is_inverted() const
+	{
+		return _inverted_flags[_current_ply_id];
+	}
+
+	bool EpisodeTrace::is_draw() const
+	{
+		return false;
+	}
+}
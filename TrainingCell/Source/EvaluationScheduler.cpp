@@ -0,0 +1,142 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "../Headers/EvaluationScheduler.h"
+
+namespace TrainingCell
+{
+	EvaluationScheduler::AfterstateValuesAwaiter::AfterstateValuesAwaiter(EvaluationScheduler& scheduler,
+		const Request& request) : _scheduler(scheduler), _request(request)
+	{}
+
+	bool EvaluationScheduler::AfterstateValuesAwaiter::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	void EvaluationScheduler::AfterstateValuesAwaiter::await_suspend(const std::coroutine_handle<> handle)
+	{
+		_request.handle = handle;
+		_scheduler._pending.push_back(_request);
+	}
+
+	void EvaluationScheduler::AfterstateValuesAwaiter::await_resume() const noexcept
+	{}
+
+	EvaluationScheduler::EvaluationScheduler(const int max_batch_size) : _max_batch_size(max_batch_size)
+	{
+		if (_max_batch_size <= 0)
+			throw std::exception("Invalid maximal batch size");
+
+		// afterstates of different states do not share a common "base" state,
+		// so that the first layer is fed directly from their sparse representations
+		_evaluator.set_first_layer_mode(FirstLayerMode::Fused);
+	}
+
+	EvaluationScheduler::AfterstateValuesAwaiter EvaluationScheduler::evaluate_afterstates(const INet& net,
+		const IMinimalStateReadonly& state, std::vector<double>& out_values)
+	{
+		return { *this, { &net, &state, &out_values } };
+	}
+
+	void EvaluationScheduler::spawn(CoTask<void>&& task)
+	{
+		_tasks.push_back(std::move(task));
+	}
+
+	void EvaluationScheduler::evaluate_batch(const INet& net)
+	{
+		net.evaluate_afterstates(_batch_states, _evaluator);
+		const auto& values = _evaluator.values();
+		auto values_offset = values.begin();
+
+		for (const auto request_id : _batch_request_ids)
+		{
+			const auto& request = _in_flight[request_id];
+			const auto moves_count = request.state_ptr->get_moves_count();
+			request.out_values_ptr->assign(values_offset, values_offset + moves_count);
+			values_offset += moves_count;
+		}
+
+		_batch_states.clear();
+		_batch_request_ids.clear();
+	}
+
+	void EvaluationScheduler::flush()
+	{
+		std::swap(_pending, _in_flight);
+		_pending.clear();
+
+		// requests are grouped by the nets (their order within a group is preserved)
+		for (auto first_request_id = 0; first_request_id < static_cast<int>(_in_flight.size()); ++first_request_id)
+		{
+			const auto net_ptr = _in_flight[first_request_id].net_ptr;
+
+			if (net_ptr == nullptr) // the request has already been evaluated
+				continue;
+
+			auto items_count = 0;
+
+			for (auto request_id = first_request_id; request_id < static_cast<int>(_in_flight.size()); ++request_id)
+			{
+				auto& request = _in_flight[request_id];
+
+				if (request.net_ptr != net_ptr)
+					continue;
+
+				const auto moves_count = request.state_ptr->get_moves_count();
+
+				if (!_batch_states.empty() && items_count + moves_count > _max_batch_size)
+				{
+					evaluate_batch(*net_ptr);
+					items_count = 0;
+				}
+
+				_batch_states.push_back(request.state_ptr);
+				_batch_request_ids.push_back(request_id);
+				items_count += moves_count;
+				request.net_ptr = nullptr;
+			}
+
+			evaluate_batch(*net_ptr);
+		}
+
+		// values of all the requests are calculated with the same state of the nets
+		// (the resumed games are free to update the nets afterward)
+		for (const auto& request : _in_flight)
+			request.handle.resume();
+	}
+
+	void EvaluationScheduler::run()
+	{
+		auto tasks = std::move(_tasks);
+		_tasks.clear();
+
+		for (const auto& task : tasks)
+			task.resume();
+
+		while (!_pending.empty())
+			flush();
+
+		for (auto& task : tasks)
+		{
+			if (!task.done())
+				throw std::exception("A task is suspended on something other than an evaluation request");
+
+			task.get();
+		}
+	}
+}
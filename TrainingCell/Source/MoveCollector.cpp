@@ -16,6 +16,7 @@
 //SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "../Headers/MoveCollector.h"
+#include <algorithm>
 
 namespace TrainingCell
 {
@@ -24,17 +25,17 @@ namespace TrainingCell
 		_collection.reserve(_capacity);
 	}
 
-	void MoveCollector::add(const int move_id, const double move_value, const DeepLearning::CpuDC::tensor_t& afterstate)
+	void MoveCollector::add(const int move_id, const double move_value)
 	{
 		if (_collection.size() < _capacity)
-			_collection.emplace_back(move_id, move_value, afterstate);
+			_collection.emplace_back(move_id, move_value);
 		else
 		{
 			const auto smallest_element = std::ranges::min_element(_collection,
 				[](const auto& a, const auto& b) { return a.value < b.value; });
 
 			if (smallest_element->value < move_value)
-				*smallest_element = { move_id, move_value, afterstate };
+				*smallest_element = { move_id, move_value };
 		}
 	}
 
@@ -22,8 +22,7 @@ namespace TrainingCell
 	bool MoveData::operator==(const MoveData& anotherData) const
 	{
 		return move_id == anotherData.move_id &&
-			value == anotherData.value &&
-			after_state == anotherData.after_state;
+			value == anotherData.value;
 	}
 
 	bool MoveData::operator!=(const MoveData& anotherData) const
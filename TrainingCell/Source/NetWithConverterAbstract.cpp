@@ -16,15 +16,33 @@
 //SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "../Headers/NetWithConverterAbstract.h"
+#include "../../DeepLearning/DeepLearning/NeuralNet/NLayer.h"
+#include <algorithm>
 
 namespace TrainingCell
 {
+	thread_local SparseInputNet NetWithConverterAbstract::_sparse_net{};
+	thread_local DeepLearning::Net<DeepLearning::CpuDC>::Context NetWithConverterAbstract::_context{};
+	thread_local DeepLearning::CpuDC::tensor_t NetWithConverterAbstract::_value_shared{};
+	thread_local BatchNetTrainer NetWithConverterAbstract::_batch_trainer{};
+	thread_local std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> NetWithConverterAbstract::_gradient_shared{};
+
 	void NetWithConverterAbstract::calc_gradient_and_value(const DeepLearning::CpuDC::tensor_t& state,
 		const DeepLearning::CpuDC::tensor_t& target_value, const DeepLearning::CostFunctionId& cost_func_id,
 		std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& out_gradient,
 		DeepLearning::CpuDC::tensor_t& out_value, const double gradient_scale_factor,
 		DeepLearning::Net<DeepLearning::CpuDC>::Context& context) const
 	{
+		if (_sparse_input && cost_func_id == DeepLearning::CostFunctionId::LINEAR)
+		{
+			_sparse_net.assign_input(state);
+			const auto value = _sparse_net.calc_gradient_and_value(net(), out_gradient,
+				static_cast<DeepLearning::Real>(gradient_scale_factor));
+			out_value.resize(1, 1, 1);
+			out_value[0] = static_cast<DeepLearning::Real>(value);
+			return;
+		}
+
 		net().calc_gradient_and_value(state,
 			target_value, cost_func_id,
 			out_gradient,
@@ -34,17 +52,166 @@ namespace TrainingCell
 	double NetWithConverterAbstract::evaluate(const std::vector<int>& state, DeepLearning::CpuDC::tensor_t& out_state_converted,
 		DeepLearning::Net<DeepLearning::CpuDC>::Context& comp_context) const
 	{
+		if (_sparse_input)
+		{
+			// the state is converted only once (into the sparse form), the dense form is "scattered" from it
+			auto& sparse_state = _sparse_net.input();
+			converter().convert(state, sparse_state);
+
+			out_state_converted.resize(1, 1, calc_input_net_size(state.size(), converter()));
+			std::fill_n(out_state_converted.begin(), out_state_converted.size(), static_cast<DeepLearning::Real>(0));
+
+			for (auto item_id = 0ull; item_id < sparse_state.ids.size(); ++item_id)
+				out_state_converted[sparse_state.ids[item_id]] = sparse_state.values[item_id];
+
+			return _sparse_net.evaluate(net());
+		}
+
 		converter().convert(state, out_state_converted);
 		net().act(out_state_converted, comp_context);
 		return comp_context.get_out()(0, 0, 0);
 	}
 
+	void NetWithConverterAbstract::convert(const std::vector<int>& state, DeepLearning::CpuDC::tensor_t& out_state_converted) const
+	{
+		converter().convert(state, out_state_converted);
+	}
+
+	void NetWithConverterAbstract::evaluate_afterstates(const IMinimalStateReadonly& state,
+		BatchNetEvaluator& evaluator) const
+	{
+		const auto moves_count = state.get_moves_count();
+		const auto item_size = static_cast<int>(net().in_size().coord_prod());
+		evaluator.reset(moves_count, item_size);
+
+		auto& state_vector = evaluator.aux_state();
+		const auto convert = [&](auto&& out)
+		{
+			if (static_cast<int>(state_vector.size()) * converter().get_expansion_factor() != item_size)
+				throw std::exception("The net is incompatible with the state.");
+
+			converter().convert(state_vector, out);
+		};
+
+		const auto first_layer_mode = evaluator.get_first_layer_mode();
+
+		if (first_layer_mode == FirstLayerMode::Incremental)
+		{
+			state.evaluate(state_vector);
+			convert(evaluator.base_item());
+		}
+
+		for (auto move_id = 0; move_id < moves_count; ++move_id)
+		{
+			state.evaluate(move_id, state_vector);
+
+			if (first_layer_mode == FirstLayerMode::Fused)
+				convert(evaluator.sparse_item(move_id));
+			else
+				convert(evaluator.item(move_id));
+		}
+
+		evaluator.evaluate(net());
+	}
+
+	void NetWithConverterAbstract::evaluate_afterstates(const std::vector<const IMinimalStateReadonly*>& states,
+		BatchNetEvaluator& evaluator) const
+	{
+		const auto first_layer_mode = evaluator.get_first_layer_mode();
+
+		if (first_layer_mode == FirstLayerMode::Incremental)
+			throw std::exception("Incremental mode is not applicable to afterstates of different states.");
+
+		auto items_count = 0;
+		for (const auto state_ptr : states)
+			items_count += state_ptr->get_moves_count();
+
+		const auto item_size = static_cast<int>(net().in_size().coord_prod());
+		evaluator.reset(items_count, item_size);
+
+		auto& state_vector = evaluator.aux_state();
+		auto item_id = 0;
+
+		for (const auto state_ptr : states)
+		{
+			const auto moves_count = state_ptr->get_moves_count();
+
+			for (auto move_id = 0; move_id < moves_count; ++move_id, ++item_id)
+			{
+				state_ptr->evaluate(move_id, state_vector);
+
+				if (static_cast<int>(state_vector.size()) * converter().get_expansion_factor() != item_size)
+					throw std::exception("The net is incompatible with the state.");
+
+				if (first_layer_mode == FirstLayerMode::Fused)
+					converter().convert(state_vector, evaluator.sparse_item(item_id));
+				else
+					converter().convert(state_vector, evaluator.item(item_id));
+			}
+		}
+
+		evaluator.evaluate(net());
+	}
+
 	void NetWithConverterAbstract::update(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient,
 		const double learning_rate, const double& lambda)
 	{
 		net().update(gradient, static_cast<DeepLearning::Real>(learning_rate), static_cast<DeepLearning::Real>(lambda));
 	}
 
+	double NetWithConverterAbstract::td_zero_update(const DeepLearning::CpuDC::tensor_t& state,
+		const double target_value, const double learning_rate)
+	{
+		if (_sparse_input)
+		{
+			_sparse_net.assign_input(state);
+			return _sparse_net.td_zero_update(net(), static_cast<DeepLearning::Real>(target_value),
+				static_cast<DeepLearning::Real>(learning_rate));
+		}
+
+		// In the "dense" mode TD(0) update is done as a TD(lambda) one with zero trace decay
+		// (so that the result is bit-exact with the one of the general TD(lambda) implementation).
+		if (!is_compatible(_gradient_shared))
+			allocate(_gradient_shared, /*assign zero*/ true);
+
+		return NetWithConverterAbstract::td_lambda_update(state, target_value, learning_rate, 0.0, _gradient_shared);
+	}
+
+	double NetWithConverterAbstract::td_lambda_update(const DeepLearning::CpuDC::tensor_t& state,
+		const double target_value, const double learning_rate, const double trace_decay,
+		std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces)
+	{
+		if (_sparse_input)
+		{
+			_sparse_net.assign_input(state);
+			return _sparse_net.td_lambda_update(net(), traces, static_cast<DeepLearning::Real>(target_value),
+				static_cast<DeepLearning::Real>(learning_rate), static_cast<DeepLearning::Real>(trace_decay));
+		}
+
+		calc_gradient_and_value(state, _value_shared, DeepLearning::CostFunctionId::LINEAR,
+			traces, _value_shared, trace_decay, _context);
+
+		const double value = _value_shared[0];
+		update(traces, -learning_rate * (target_value - value), 0.0);
+
+		return value;
+	}
+
+	void NetWithConverterAbstract::td_lambda_return_update(const std::vector<DeepLearning::CpuDC::tensor_t>& after_states,
+		const std::vector<double>& rewards, const int count, const double learning_rate,
+		const double discount, const double lambda)
+	{
+		_batch_trainer.assign_inputs(after_states, count);
+		_batch_trainer.td_lambda_return_update(net(), rewards, learning_rate, discount, lambda);
+	}
+
+	void NetWithConverterAbstract::batch_update(const std::vector<DeepLearning::Real>& after_states,
+		const std::vector<double>& targets, const int count, const double learning_rate, std::vector<double>& out_values)
+	{
+		_batch_trainer.assign_inputs(after_states, count);
+		out_values = _batch_trainer.regression_update(net(), targets, learning_rate);
+	}
+
 	bool NetWithConverterAbstract::validate_net_input_size(const std::size_t state_size) const
 	{
 		return static_cast<long long>(calc_input_net_size(state_size, converter())) == net().in_size().coord_prod();
@@ -55,9 +222,55 @@ namespace TrainingCell
 		return state_size * converter.get_expansion_factor();
 	}
 
+	void NetWithConverterAbstract::set_sparse_input(const bool sparse_input)
+	{
+		_sparse_input = sparse_input;
+	}
+
+	bool NetWithConverterAbstract::get_sparse_input() const
+	{
+		return _sparse_input;
+	}
+
 	void NetWithConverterAbstract::allocate(std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient,
 		const bool assign_zero) const
 	{
 		net().allocate(gradient, assign_zero);
 	}
+
+	bool NetWithConverterAbstract::is_compatible(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& gradient) const
+	{
+		const auto& the_net = net();
+
+		if (gradient.size() != the_net.layers_count())
+			return false;
+
+		for (auto layer_id = 0ull; layer_id < gradient.size(); ++layer_id)
+		{
+			const auto layer_ptr = dynamic_cast<const DeepLearning::NLayer<DeepLearning::CpuDC>*>(&the_net[layer_id]);
+
+			if (layer_ptr == nullptr)
+				return false;
+
+			const auto in_size = static_cast<std::size_t>(layer_ptr->in_size().coord_prod());
+			const auto out_size = static_cast<std::size_t>(layer_ptr->out_size().coord_prod());
+			const auto& layer_gradient = gradient[layer_id];
+
+			if (layer_gradient.Biases_grad.size() != out_size || layer_gradient.Weights_grad.size() != 1 ||
+				layer_gradient.Weights_grad[0].size() != in_size * out_size)
+				return false;
+		}
+
+		return true;
+	}
+
+	AfterstateValueCache* NetWithConverterAbstract::value_cache() const
+	{
+		return nullptr;
+	}
+
+	ReplayBuffer* NetWithConverterAbstract::replay_buffer()
+	{
+		return nullptr;
+	}
 }
@@ -0,0 +1,173 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/QuantizedNet.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace TrainingCell
+{
+	thread_local std::vector<DeepLearning::Real> QuantizedNet::_buffers[2]{};
+	thread_local std::vector<std::int16_t> QuantizedNet::_input_quantized{};
+	thread_local std::vector<int> QuantizedNet::_state_vector{};
+
+	namespace
+	{
+		/// <summary>
+		/// Returns maximal absolute value among the given elements.
+		/// </summary>
+		DeepLearning::Real max_abs(const DeepLearning::Real* values, const int count)
+		{
+			DeepLearning::Real result = 0;
+
+			for (auto element_id = 0; element_id < count; ++element_id)
+				result = std::max(result, std::abs(values[element_id]));
+
+			return result;
+		}
+	}
+
+	QuantizedNet::QuantizedNet(const DeepLearning::Net<DeepLearning::CpuDC>& net, const StateConverter& converter) :
+		_converter(converter)
+	{
+		std::vector<DenseLayerView> views;
+		DenseLayerView::extract(net, views);
+
+		if (views.empty() || views.rbegin()->out_size != 1)
+			throw std::exception("Net with a single output neuron is expected.");
+
+		_layers.resize(views.size());
+
+		for (auto layer_id = 0ull; layer_id < views.size(); ++layer_id)
+		{
+			const auto& view = views[layer_id];
+			auto& layer = _layers[layer_id];
+
+			layer.in_size = view.in_size;
+			layer.out_size = view.out_size;
+			layer.func_id = view.func_id;
+			layer.biases.assign(view.biases, view.biases + view.out_size);
+			layer.weights.resize(static_cast<std::size_t>(view.out_size) * view.in_size);
+			layer.row_scales.resize(view.out_size);
+
+			constexpr int weight_limit = std::numeric_limits<std::int8_t>::max();
+			layer.input_limit = std::max(1, std::min<int>(std::numeric_limits<std::int16_t>::max(),
+				std::numeric_limits<std::int32_t>::max() / (weight_limit * std::max(1, view.in_size))));
+
+			for (auto row_id = 0; row_id < view.out_size; ++row_id)
+			{
+				const auto row_offset = static_cast<std::size_t>(row_id) * view.in_size;
+				const auto weights = view.weights + row_offset;
+				const auto row_max = max_abs(weights, view.in_size);
+				const auto scale = row_max > 0 ? row_max / weight_limit : static_cast<DeepLearning::Real>(1);
+				layer.row_scales[row_id] = scale;
+
+				std::transform(weights, weights + view.in_size, layer.weights.begin() + static_cast<std::ptrdiff_t>(row_offset),
+					[scale](const auto w)
+					{
+						return static_cast<std::int8_t>(std::clamp(std::lround(w / scale),
+							-static_cast<long>(weight_limit), static_cast<long>(weight_limit)));
+					});
+			}
+		}
+	}
+
+	double QuantizedNet::evaluate_buffer() const
+	{
+		auto in_buffer_id = 0;
+
+		for (const auto& layer : _layers)
+		{
+			const auto& in = _buffers[in_buffer_id];
+			auto& out = _buffers[1 - in_buffer_id];
+			out.resize(layer.out_size);
+
+			const auto in_max = max_abs(in.data(), layer.in_size);
+
+			if (in_max <= 0)
+				std::ranges::copy(layer.biases, out.begin());
+			else
+			{
+				const auto in_scale = in_max / layer.input_limit;
+				_input_quantized.resize(layer.in_size);
+				std::transform(in.begin(), in.begin() + layer.in_size, _input_quantized.begin(),
+					[in_scale](const auto x) { return static_cast<std::int16_t>(std::lround(x / in_scale)); });
+
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					const auto weights = layer.weights.data() + static_cast<std::size_t>(row_id) * layer.in_size;
+					std::int32_t accumulator = 0;
+
+					for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+						accumulator += static_cast<std::int32_t>(weights[col_id]) * _input_quantized[col_id];
+
+					out[row_id] = layer.biases[row_id] + static_cast<DeepLearning::Real>(accumulator) *
+						layer.row_scales[row_id] * in_scale;
+				}
+			}
+
+			if (layer.func_id == DeepLearning::ActivationFunctionId::RELU)
+				std::ranges::transform(out, out.begin(),
+					[](const auto x) { return std::max(x, static_cast<DeepLearning::Real>(0)); });
+
+			in_buffer_id = 1 - in_buffer_id;
+		}
+
+		return _buffers[in_buffer_id][0];
+	}
+
+	double QuantizedNet::evaluate(const std::vector<int>& state) const
+	{
+		if (_layers.empty())
+			throw std::exception("The net is not initialized.");
+
+		const auto in_size = _layers[0].in_size;
+
+		if (state.size() * _converter.get_expansion_factor() != static_cast<std::size_t>(in_size))
+			throw std::exception("The net is incompatible with the state.");
+
+		_buffers[0].resize(in_size);
+		_converter.convert(state, _buffers[0].data());
+
+		return evaluate_buffer();
+	}
+
+	MoveData QuantizedNet::pick_move(const IMinimalStateReadonly& state) const
+	{
+		auto best_move_id = -1;
+		auto best_value = -std::numeric_limits<double>::max();
+
+		const auto actions_count = state.get_moves_count();
+		for (auto move_id = 0; move_id < actions_count; ++move_id)
+		{
+			state.evaluate(move_id, _state_vector);
+			const auto value = evaluate(_state_vector);
+
+			if (value > best_value)
+			{
+				best_move_id = move_id;
+				best_value = value;
+			}
+		}
+
+		if (best_move_id < 0)
+			throw std::exception("Neural network is NaN. Try decreasing learning rate parameter.");
+
+		return { best_move_id, best_value };
+	}
+}
@@ -0,0 +1,170 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/ReplayBuffer.h"
+#include "../Headers/INet.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace TrainingCell
+{
+	ReplayBuffer::ReplayBuffer(const int capacity, const int batch_size, const int replay_interval, const bool prioritized) :
+		_capacity(capacity), _batch_size(batch_size), _replay_interval(replay_interval), _prioritized(prioritized)
+	{
+		if (_capacity < 0 || _batch_size <= 0 || _replay_interval <= 0)
+			throw std::exception("Invalid parameters of the replay buffer");
+
+		if (_prioritized && _capacity > 0)
+		{
+			_leaves_offset = std::bit_ceil(static_cast<std::size_t>(_capacity));
+			_priorities.assign(2 * _leaves_offset, 0.0);
+		}
+	}
+
+	ReplayBuffer::ReplayBuffer(const ReplayBuffer& another_buffer) :
+		ReplayBuffer(another_buffer._capacity, another_buffer._batch_size,
+			another_buffer._replay_interval, another_buffer._prioritized)
+	{}
+
+	ReplayBuffer& ReplayBuffer::operator=(const ReplayBuffer& another_buffer)
+	{
+		if (this != &another_buffer)
+			*this = ReplayBuffer(another_buffer._capacity, another_buffer._batch_size,
+				another_buffer._replay_interval, another_buffer._prioritized);
+
+		return *this;
+	}
+
+	bool ReplayBuffer::has_configuration(const int capacity, const int batch_size,
+		const int replay_interval, const bool prioritized) const
+	{
+		return _capacity == capacity && _batch_size == batch_size &&
+			_replay_interval == replay_interval && _prioritized == prioritized;
+	}
+
+	bool ReplayBuffer::is_enabled() const
+	{
+		return _capacity > 0;
+	}
+
+	int ReplayBuffer::get_size() const
+	{
+		return _size;
+	}
+
+	void ReplayBuffer::clear()
+	{
+		_size = 0;
+		_next_id = 0;
+		_added_since_replay = 0;
+		std::fill(_priorities.begin(), _priorities.end(), 0.0);
+	}
+
+	void ReplayBuffer::update_priority(const int sample_id, const double value, const double target)
+	{
+		auto node_id = _leaves_offset + sample_id;
+		const auto delta = std::abs(target - value) + PriorityOffset - _priorities[node_id];
+
+		for (; node_id > 0; node_id /= 2)
+			_priorities[node_id] += delta;
+	}
+
+	int ReplayBuffer::draw_sample_id()
+	{
+		if (!_prioritized)
+			return _generator.get_int(0, _size);
+
+		auto threshold = _generator.next() * _priorities[1];
+		auto node_id = static_cast<std::size_t>(1);
+
+		while (node_id < _leaves_offset)
+		{
+			node_id *= 2;
+
+			if (threshold >= _priorities[node_id])
+			{
+				threshold -= _priorities[node_id];
+				++node_id;
+			}
+		}
+
+		// round-off errors can lead us to an empty leaf
+		return std::min(static_cast<int>(node_id - _leaves_offset), _size - 1);
+	}
+
+	void ReplayBuffer::add(const DeepLearning::CpuDC::tensor_t& after_state, const double value, const double target,
+		INet& net, const double learning_rate)
+	{
+		if (!is_enabled())
+			throw std::exception("The replay buffer is disabled");
+
+		if (static_cast<int>(after_state.size()) != _item_size)
+		{
+			// the first sample (or a sample of a different kind) defines layout of the storage
+			clear();
+			_item_size = static_cast<int>(after_state.size());
+			_after_states.resize(static_cast<std::size_t>(_capacity) * _item_size);
+			_targets.resize(_capacity);
+		}
+
+		std::copy(after_state.begin(), after_state.end(),
+			_after_states.begin() + static_cast<std::size_t>(_next_id) * _item_size);
+		_targets[_next_id] = target;
+
+		if (_prioritized)
+			update_priority(_next_id, value, target);
+
+		_next_id = (_next_id + 1) % _capacity;
+		_size = std::min(_size + 1, _capacity);
+
+		if (++_added_since_replay < _replay_interval || _size < _batch_size)
+			return;
+
+		_added_since_replay = 0;
+		replay(net, learning_rate);
+	}
+
+	void ReplayBuffer::replay(INet& net, const double learning_rate)
+	{
+		_batch_ids.resize(_batch_size);
+		_batch_after_states.resize(static_cast<std::size_t>(_batch_size) * _item_size);
+		_batch_targets.resize(_batch_size);
+
+		for (auto item_id = 0; item_id < _batch_size; ++item_id)
+		{
+			const auto sample_id = draw_sample_id();
+			_batch_ids[item_id] = sample_id;
+
+			const auto sample_begin = _after_states.begin() + static_cast<std::size_t>(sample_id) * _item_size;
+			std::copy(sample_begin, sample_begin + _item_size,
+				_batch_after_states.begin() + static_cast<std::size_t>(item_id) * _item_size);
+			_batch_targets[item_id] = _targets[sample_id];
+		}
+
+		net.batch_update(_batch_after_states, _batch_targets, _batch_size, learning_rate, _batch_values);
+
+		if (!_prioritized)
+			return;
+
+		for (auto item_id = 0; item_id < _batch_size; ++item_id)
+		{
+			const auto sample_id = _batch_ids[item_id];
+			update_priority(sample_id, _batch_values[item_id], _targets[sample_id]);
+		}
+	}
+}
@@ -0,0 +1,363 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/SparseInputNet.h"
+#include <algorithm>
+
+namespace TrainingCell
+{
+	double SparseInputNet::forward()
+	{
+		const auto layers_count = _layers.size();
+		_pre_activations.resize(layers_count);
+		_activations.resize(layers_count);
+
+		for (auto layer_id = 0ull; layer_id < layers_count; ++layer_id)
+		{
+			const auto& layer = _layers[layer_id];
+			auto& pre_activation = _pre_activations[layer_id];
+			pre_activation.resize(layer.out_size);
+
+			if (layer_id == 0)
+			{
+				const auto non_zero_count = _input.ids.size();
+
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					const auto weights = layer.weights + static_cast<std::size_t>(row_id) * layer.in_size;
+					DeepLearning::Real sum = layer.biases[row_id];
+
+					for (auto element_id = 0ull; element_id < non_zero_count; ++element_id)
+						sum += _input.values[element_id] * weights[_input.ids[element_id]];
+
+					pre_activation[row_id] = sum;
+				}
+			}
+			else
+			{
+				const auto& in = _activations[layer_id - 1];
+
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					const auto weights = layer.weights + static_cast<std::size_t>(row_id) * layer.in_size;
+					DeepLearning::Real sum = layer.biases[row_id];
+
+					for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+						sum += weights[col_id] * in[col_id];
+
+					pre_activation[row_id] = sum;
+				}
+			}
+
+			auto& activation = _activations[layer_id];
+			activation = pre_activation;
+			layer.activate(activation.data(), layer.out_size);
+		}
+
+		return _activations.rbegin()->at(0);
+	}
+
+	SparseState& SparseInputNet::input()
+	{
+		return _input;
+	}
+
+	void SparseInputNet::assign_input(const DeepLearning::CpuDC::tensor_t& dense_input)
+	{
+		_input.clear();
+		const auto size = static_cast<int>(dense_input.size());
+
+		for (auto element_id = 0; element_id < size; ++element_id)
+		{
+			if (dense_input[element_id] == 0)
+				continue;
+
+			_input.ids.push_back(element_id);
+			_input.values.push_back(dense_input[element_id]);
+		}
+	}
+
+	double SparseInputNet::evaluate(const DeepLearning::Net<DeepLearning::CpuDC>& net)
+	{
+		DenseLayerView::extract(net, _layers);
+		return forward();
+	}
+
+	double SparseInputNet::calc_gradient_and_value(const DeepLearning::Net<DeepLearning::CpuDC>& net,
+		std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& out_gradient, const DeepLearning::Real scale)
+	{
+		DenseLayerView::extract(net, _layers);
+
+		if (out_gradient.size() != _layers.size())
+			throw std::exception("Gradient container is incompatible with the net.");
+
+		const auto result = forward();
+
+		// derivative of the (one-dimensional) output with respect to itself
+		_deltas[0].assign(1, static_cast<DeepLearning::Real>(1));
+		auto delta_id = 0;
+
+		for (auto layer_id = static_cast<int>(_layers.size()) - 1; layer_id >= 0; --layer_id)
+		{
+			const auto& layer = _layers[layer_id];
+			const auto& pre_activation = _pre_activations[layer_id];
+			auto& delta = _deltas[delta_id];
+
+			// convert derivatives with respect to the output of the layer
+			// into derivatives with respect to its pre-activation
+			if (layer.func_id == DeepLearning::ActivationFunctionId::RELU)
+			{
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					if (pre_activation[row_id] <= 0)
+						delta[row_id] = 0;
+				}
+			}
+
+			auto& gradient = out_gradient[layer_id];
+			const auto bias_grad = gradient.Biases_grad.begin();
+			const auto weight_grad = gradient.Weights_grad[0].begin();
+
+			for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				bias_grad[row_id] = scale * bias_grad[row_id] + delta[row_id];
+
+			if (layer_id == 0)
+			{
+				const auto weights_count = static_cast<std::size_t>(layer.out_size) * layer.in_size;
+
+				if (scale != static_cast<DeepLearning::Real>(1))
+					std::transform(weight_grad, weight_grad + weights_count, weight_grad,
+						[scale](const auto x) { return scale * x; });
+
+				const auto non_zero_count = _input.ids.size();
+
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					const auto row_delta = delta[row_id];
+
+					if (row_delta == 0)
+						continue;
+
+					const auto weight_grad_row = weight_grad + static_cast<std::size_t>(row_id) * layer.in_size;
+
+					for (auto element_id = 0ull; element_id < non_zero_count; ++element_id)
+						weight_grad_row[_input.ids[element_id]] += row_delta * _input.values[element_id];
+				}
+
+				continue;
+			}
+
+			const auto& in = _activations[layer_id - 1];
+			auto& delta_next = _deltas[delta_id ^ 1];
+			delta_next.assign(layer.in_size, static_cast<DeepLearning::Real>(0));
+
+			for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+			{
+				const auto row_delta = delta[row_id];
+				const auto weights_row = layer.weights + static_cast<std::size_t>(row_id) * layer.in_size;
+				const auto weight_grad_row = weight_grad + static_cast<std::size_t>(row_id) * layer.in_size;
+
+				for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+				{
+					weight_grad_row[col_id] = scale * weight_grad_row[col_id] + row_delta * in[col_id];
+					delta_next[col_id] += weights_row[col_id] * row_delta;
+				}
+			}
+
+			delta_id ^= 1;
+		}
+
+		return result;
+	}
+
+	double SparseInputNet::td_zero_update(DeepLearning::Net<DeepLearning::CpuDC>& net,
+		const DeepLearning::Real target_value, const DeepLearning::Real learning_rate)
+	{
+		DenseLayerView::extract(net, _layers);
+		const auto result = forward();
+		const auto step = learning_rate * (target_value - static_cast<DeepLearning::Real>(result));
+
+		// derivative of the (one-dimensional) output with respect to itself
+		_deltas[0].assign(1, static_cast<DeepLearning::Real>(1));
+		auto delta_id = 0;
+
+		for (auto layer_id = static_cast<int>(_layers.size()) - 1; layer_id >= 0; --layer_id)
+		{
+			const auto& layer = _layers[layer_id];
+			const auto& pre_activation = _pre_activations[layer_id];
+			auto& delta = _deltas[delta_id];
+
+			if (layer.func_id == DeepLearning::ActivationFunctionId::RELU)
+			{
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					if (pre_activation[row_id] <= 0)
+						delta[row_id] = 0;
+				}
+			}
+
+			// the net is accessed via a non-constant reference, so that the parameters can be modified
+			const auto weights = const_cast<DeepLearning::Real*>(layer.weights);
+			const auto biases = const_cast<DeepLearning::Real*>(layer.biases);
+
+			if (layer_id == 0)
+			{
+				const auto non_zero_count = _input.ids.size();
+
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					const auto row_step = step * delta[row_id];
+
+					if (row_step == 0)
+						continue;
+
+					biases[row_id] += row_step;
+					const auto weights_row = weights + static_cast<std::size_t>(row_id) * layer.in_size;
+
+					for (auto element_id = 0ull; element_id < non_zero_count; ++element_id)
+						weights_row[_input.ids[element_id]] += row_step * _input.values[element_id];
+				}
+
+				continue;
+			}
+
+			const auto& in = _activations[layer_id - 1];
+			auto& delta_next = _deltas[delta_id ^ 1];
+			delta_next.assign(layer.in_size, static_cast<DeepLearning::Real>(0));
+
+			for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+			{
+				const auto row_delta = delta[row_id];
+
+				if (row_delta == 0)
+					continue;
+
+				const auto row_step = step * row_delta;
+				biases[row_id] += row_step;
+				const auto weights_row = weights + static_cast<std::size_t>(row_id) * layer.in_size;
+
+				for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+				{
+					// derivative is calculated with the weight before the update
+					delta_next[col_id] += weights_row[col_id] * row_delta;
+					weights_row[col_id] += row_step * in[col_id];
+				}
+			}
+
+			delta_id ^= 1;
+		}
+
+		return result;
+	}
+
+	double SparseInputNet::td_lambda_update(DeepLearning::Net<DeepLearning::CpuDC>& net,
+		std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces, const DeepLearning::Real target_value,
+		const DeepLearning::Real learning_rate, const DeepLearning::Real trace_decay)
+	{
+		DenseLayerView::extract(net, _layers);
+
+		if (traces.size() != _layers.size())
+			throw std::exception("Trace container is incompatible with the net.");
+
+		const auto result = forward();
+		const auto step = learning_rate * (target_value - static_cast<DeepLearning::Real>(result));
+
+		// derivative of the (one-dimensional) output with respect to itself
+		_deltas[0].assign(1, static_cast<DeepLearning::Real>(1));
+		auto delta_id = 0;
+
+		for (auto layer_id = static_cast<int>(_layers.size()) - 1; layer_id >= 0; --layer_id)
+		{
+			const auto& layer = _layers[layer_id];
+			const auto& pre_activation = _pre_activations[layer_id];
+			auto& delta = _deltas[delta_id];
+
+			if (layer.func_id == DeepLearning::ActivationFunctionId::RELU)
+			{
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					if (pre_activation[row_id] <= 0)
+						delta[row_id] = 0;
+				}
+			}
+
+			// the net is accessed via a non-constant reference, so that the parameters can be modified
+			const auto weights = const_cast<DeepLearning::Real*>(layer.weights);
+			const auto biases = const_cast<DeepLearning::Real*>(layer.biases);
+			const auto bias_traces = traces[layer_id].Biases_grad.begin();
+			const auto weight_traces = traces[layer_id].Weights_grad[0].begin();
+
+			for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+			{
+				bias_traces[row_id] = trace_decay * bias_traces[row_id] + delta[row_id];
+				biases[row_id] += step * bias_traces[row_id];
+			}
+
+			if (layer_id == 0)
+			{
+				const auto non_zero_count = _input.ids.size();
+
+				for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+				{
+					const auto offset = static_cast<std::size_t>(row_id) * layer.in_size;
+					const auto weights_row = weights + offset;
+					const auto traces_row = weight_traces + offset;
+					const auto row_delta = delta[row_id];
+
+					// the row is small enough to stay in cache between the loops below
+					for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+						traces_row[col_id] *= trace_decay;
+
+					if (row_delta != 0)
+					{
+						for (auto element_id = 0ull; element_id < non_zero_count; ++element_id)
+							traces_row[_input.ids[element_id]] += row_delta * _input.values[element_id];
+					}
+
+					for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+						weights_row[col_id] += step * traces_row[col_id];
+				}
+
+				continue;
+			}
+
+			const auto& in = _activations[layer_id - 1];
+			auto& delta_next = _deltas[delta_id ^ 1];
+			delta_next.assign(layer.in_size, static_cast<DeepLearning::Real>(0));
+
+			for (auto row_id = 0; row_id < layer.out_size; ++row_id)
+			{
+				const auto offset = static_cast<std::size_t>(row_id) * layer.in_size;
+				const auto weights_row = weights + offset;
+				const auto traces_row = weight_traces + offset;
+				const auto row_delta = delta[row_id];
+
+				for (auto col_id = 0; col_id < layer.in_size; ++col_id)
+				{
+					// derivative is calculated with the weight before the update
+					delta_next[col_id] += weights_row[col_id] * row_delta;
+					traces_row[col_id] = trace_decay * traces_row[col_id] + row_delta * in[col_id];
+					weights_row[col_id] += step * traces_row[col_id];
+				}
+			}
+
+			delta_id ^= 1;
+		}
+
+		return result;
+	}
+}
@@ -16,55 +16,44 @@
 //SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "../Headers/StateConverter.h"
-#include "../Headers/Chess/PieceController.h"
+#include "../Headers/StateConversionKernel.h"
 
 namespace TrainingCell
 {
+	namespace
+	{
+		/// <summary>
+		/// Dispatches conversion of the given input to the kernel that corresponds to the given conversion type.
+		/// </summary>
+		template <class O>
+		void convert_with_kernel(const StateConversionType type, const std::vector<int>& in, O&& out)
+		{
+			switch (type)
+			{
+			case StateConversionType::CheckersStandard:
+				StateConversionKernel<StateConversionType::CheckersStandard>::convert(in, out);
+				return;
+			case StateConversionType::ChessStandard:
+				StateConversionKernel<StateConversionType::ChessStandard>::convert(in, out);
+				return;
+			default:
+				throw std::exception("Uninitialized converter.");
+			}
+		}
+	}
+
 	void StateConverter::activate()
 	{
 		switch (_type)
 		{
 		case StateConversionType::None:
-			_operator = [](const std::vector<int>& in, DeepLearning::CpuDC::tensor_t& out)
-			{
-				throw std::exception("Uninitialized converter.");
-			};
+			_expansion_factor = -1;
 			return;
 		case StateConversionType::CheckersStandard:
-			_expansion_factor = 1;
-			_operator = [](const std::vector<int>& in, DeepLearning::CpuDC::tensor_t& out)
-			{
-				out.resize(1, 1, in.size());
-#ifdef USE_SINGLE_PRECISION
-#pragma warning(push)
-#pragma warning(disable: 4244)
-#endif
-				std::ranges::copy(in, out.begin());
-#ifdef USE_SINGLE_PRECISION
-#pragma warning(pop)
-#endif
-				};
+			_expansion_factor = StateConversionKernel<StateConversionType::CheckersStandard>::ExpansionFactor;
 			return;
 		case StateConversionType::ChessStandard:
-			_expansion_factor = Chess::PieceController::RankBitsCount;
-			_operator = [](const std::vector<int>& in, DeepLearning::CpuDC::tensor_t& out)
-			{
-				constexpr int channels = Chess::PieceController::RankBitsCount;
-				out.resize(1, 1, in.size() * channels);
-				const auto out_ptr = out.begin();
-
-				auto out_item_id = 0;
-				for (const auto piece_token : in)
-				{
-					const auto positive = !Chess::PieceController::is_rival_piece(piece_token);
-
-					for (auto channel_id = 0; channel_id < channels; ++channel_id)
-					{
-						const auto bit_present = static_cast<int>((piece_token & (1 << channel_id)) != 0);
-						out_ptr[out_item_id++] = static_cast<DeepLearning::Real>(positive ? bit_present : -bit_present);
-					}
-				}
-			};
+			_expansion_factor = StateConversionKernel<StateConversionType::ChessStandard>::ExpansionFactor;
 			return;
 		}
 
@@ -92,7 +81,21 @@ namespace TrainingCell
 
 	void StateConverter::convert(const std::vector<int>& in, DeepLearning::CpuDC::tensor_t& out) const
 	{
-		_operator(in, out);
+		if (_expansion_factor <= 0)
+			throw std::exception("Uninitialized converter.");
+
+		out.resize(1, 1, in.size() * _expansion_factor);
+		convert_with_kernel(_type, in, out.begin());
+	}
+
+	void StateConverter::convert(const std::vector<int>& in, DeepLearning::Real* out) const
+	{
+		convert_with_kernel(_type, in, out);
+	}
+
+	void StateConverter::convert(const std::vector<int>& in, SparseState& out) const
+	{
+		convert_with_kernel(_type, in, out);
 	}
 
 	bool StateConverter::operator==(const StateConverter& anotherConverter) const
@@ -32,6 +32,12 @@ namespace TrainingCell
 		return _state.yield(initialize_recorder);
 	}
 
+	template <class S>
+	void StateEditor<S>::yield(std::unique_ptr<IState>& state_ptr, const bool initialize_recorder) const
+	{
+		_state.yield(state_ptr, initialize_recorder);
+	}
+
 	template <class S>
 	StateTypeId StateEditor<S>::state_type() const
 	{
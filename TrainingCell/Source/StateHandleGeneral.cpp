@@ -24,15 +24,35 @@
 namespace TrainingCell
 {
 	template <class S>
-	StateHandleGeneral<S>::StateHandleGeneral(S state, const bool initialize_recorder) : _state(std::move(state))
+	void StateHandleGeneral<S>::initialize(const bool initialize_recorder)
 	{
 		_is_draw = _state.get_moves(_actions);
 
-		if (initialize_recorder)
+		if (!initialize_recorder)
 		{
-			_trace_recorder_ptr = std::make_unique<StateTraceRecorder<typename S::BaseState>>(_state);
-			_trace_recorder_ptr->add_record(S::Move::invalid(), _is_draw);
+			_trace_recorder_ptr.reset();
+			return;
 		}
+
+		if (_trace_recorder_ptr)
+			_trace_recorder_ptr->reset(_state);
+		else
+			_trace_recorder_ptr = std::make_unique<StateTraceRecorder<typename S::BaseState>>(_state);
+
+		_trace_recorder_ptr->add_record(S::Move::invalid(), _is_draw);
+	}
+
+	template <class S>
+	StateHandleGeneral<S>::StateHandleGeneral(S state, const bool initialize_recorder) : _state(std::move(state))
+	{
+		initialize(initialize_recorder);
+	}
+
+	template <class S>
+	void StateHandleGeneral<S>::reset(const S& state, const bool initialize_recorder)
+	{
+		_state = state;
+		initialize(initialize_recorder);
 	}
 
 	template <class S>
@@ -47,12 +67,24 @@ namespace TrainingCell
 		return _state.get_vector(_actions[move_id]);
 	}
 
+	template <class S>
+	void StateHandleGeneral<S>::evaluate(const int move_id, std::vector<int>& out_afterstate) const
+	{
+		_state.get_vector(_actions[move_id], out_afterstate);
+	}
+
 	template <class S>
 	std::vector<int> StateHandleGeneral<S>::evaluate() const
 	{
 		return _state.to_vector();
 	}
 
+	template <class S>
+	void StateHandleGeneral<S>::evaluate(std::vector<int>& out_state) const
+	{
+		_state.to_vector(out_state);
+	}
+
 	template <class S>
 	double StateHandleGeneral<S>::calc_reward(const std::vector<int>& prev_state,
 		const std::vector<int>& next_state) const
@@ -25,6 +25,15 @@ namespace TrainingCell
 	StateTraceRecorder<S>::StateTraceRecorder(const S& init_state) : S(init_state)
 	{}
 
+	template <class S>
+	void StateTraceRecorder<S>::reset(const S& init_state)
+	{
+		static_cast<S&>(*this) = init_state;
+		_moves_counter = 0;
+		_moves.clear();
+		_draw_flags.clear();
+	}
+
 	template <class S>
 	void StateTraceRecorder<S>::add_record(const typename S::Move& move, const bool draw_flag)
 	{
@@ -49,7 +58,7 @@ namespace TrainingCell
 	}
 
 	template <class S>
-	bool StateTraceRecorder<S>::get_moves(std::vector<typename S::Move>& out_result) const
+	bool StateTraceRecorder<S>::get_moves(typename S::MoveList& out_result) const
 	{
 		// sanity check
 		if (_moves_counter > _moves.size() || _moves_counter >= _draw_flags.size())
@@ -17,13 +17,75 @@
 
 #include "../Headers/TdLambdaSubAgent.h"
 #include "../Headers/MoveCollector.h"
+#include "../Headers/EligibilityTracePool.h"
 #include <cmath>
+#include <algorithm>
 
 namespace TrainingCell
 {
+	namespace
+	{
+		/// <summary>
+		/// Returns "true" if the given tensors are of the same size and have equal elements;
+		/// elements of a tensor marked as "zero" are treated as zeros regardless of their actual values.
+		/// </summary>
+		bool equal_tensors(const DeepLearning::CpuDC::tensor_t& tensor, const bool zero,
+			const DeepLearning::CpuDC::tensor_t& another_tensor, const bool another_zero)
+		{
+			if (tensor.size() != another_tensor.size())
+				return false;
+
+			const auto data = tensor.begin();
+			const auto another_data = another_tensor.begin();
+
+			for (auto item_id = 0ull; item_id < tensor.size(); ++item_id)
+			{
+				if ((zero ? 0 : data[item_id]) != (another_zero ? 0 : another_data[item_id]))
+					return false;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Returns "true" if the given eligibility traces are equal; traces marked as "reset"
+		/// are treated as zeros regardless of their actual values (see "TdLambdaSubAgent::_reset_traces").
+		/// </summary>
+		bool equal_traces(const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& traces, const bool reset,
+			const std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>& another_traces, const bool another_reset)
+		{
+			if (!reset && !another_reset)
+				return traces == another_traces;
+
+			if (traces.size() != another_traces.size())
+				return false;
+
+			for (auto layer_id = 0ull; layer_id < traces.size(); ++layer_id)
+			{
+				const auto& layer_traces = traces[layer_id];
+				const auto& another_layer_traces = another_traces[layer_id];
+
+				if (!equal_tensors(layer_traces.Biases_grad, reset, another_layer_traces.Biases_grad, another_reset) ||
+					layer_traces.Weights_grad.size() != another_layer_traces.Weights_grad.size())
+					return false;
+
+				for (auto weights_id = 0ull; weights_id < layer_traces.Weights_grad.size(); ++weights_id)
+				{
+					if (!equal_tensors(layer_traces.Weights_grad[weights_id], reset,
+						another_layer_traces.Weights_grad[weights_id], another_reset))
+						return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
 	thread_local DeepLearning::RandomGenerator TdLambdaSubAgent::Explorer::_generator{};
 	thread_local DeepLearning::Net<DeepLearning::CpuDC>::Context TdLambdaSubAgent::_context{};
 	thread_local DeepLearning::CpuDC::tensor_t TdLambdaSubAgent::_tensor_shared{};
+	thread_local std::vector<int> TdLambdaSubAgent::_state_vector_shared{};
+	thread_local BatchNetEvaluator TdLambdaSubAgent::_batch_evaluator{};
 
 	bool TdLambdaSubAgent::Explorer::should_explore(const double exploration_probability)
 	{
@@ -68,64 +130,161 @@ namespace TrainingCell
 		if (actual_exploration_volume == state.get_moves_count())
 			return evaluate(state, picked_move_id, net);
 
-		MoveCollector collector(actual_exploration_volume);
+		return explore(state, net, actual_exploration_volume, picked_move_id, evaluate_afterstates(state, net));
+	}
+
+	MoveData TdLambdaSubAgent::explore(const IMinimalStateReadonly& state, const INet& net, const int exploration_volume,
+		const int picked_option_id, const std::vector<double>& values)
+	{
+		MoveCollector collector(exploration_volume);
 
 		const auto actions_count = state.get_moves_count();
 		for (auto move_id = 0; move_id < actions_count; ++move_id)
-		{
-			const auto value = evaluate(state, move_id, net, _tensor_shared, _context);
-			collector.add(move_id, value, _tensor_shared);
-		}
+			collector.add(move_id, values[move_id]);
 
-		return std::move(collector.get(picked_move_id));
+		return evaluate(state, collector.get(picked_option_id).move_id, net);
 	}
 
 	MoveData TdLambdaSubAgent::pick_move(const IMinimalStateReadonly& state, const INet& net)
 	{
-		MoveData best_move_data{ -1, -std::numeric_limits<double>::max() };
+		return pick_move(state, net, evaluate_afterstates(state, net));
+	}
+
+	MoveData TdLambdaSubAgent::pick_move(const IMinimalStateReadonly& state, const INet& net, const std::vector<double>& values)
+	{
+		auto best_move_id = -1;
+		auto best_value = -std::numeric_limits<double>::max();
 
 		const auto actions_count = state.get_moves_count();
 		for (auto move_id = 0; move_id < actions_count; ++move_id)
 		{
-			const auto value = evaluate(state, move_id, net, _tensor_shared, _context);
-
-			if (value > best_move_data.value)
+			if (values[move_id] > best_value)
 			{
-				best_move_data.move_id = move_id;
-				best_move_data.value = value;
-				best_move_data.after_state = _tensor_shared;
+				best_move_id = move_id;
+				best_value = values[move_id];
 			}
 		}
 
-		if (best_move_data.move_id < 0)
+		if (best_move_id < 0)
 			throw std::exception("Neural network is NaN. Try decreasing learning rate parameter.");
 
-		return best_move_data;
+		return evaluate(state, best_move_id, net);
+	}
+
+	const std::vector<double>& TdLambdaSubAgent::evaluate_afterstates(const IMinimalStateReadonly& state, const INet& net)
+	{
+		if (net.value_cache() != nullptr)
+		{
+			// values of the afterstates are supposed to be found in the cache, so that batching is pointless
+			auto& values = _batch_evaluator.values();
+			values.resize(state.get_moves_count());
+
+			for (auto move_id = 0; move_id < static_cast<int>(values.size()); ++move_id)
+				values[move_id] = evaluate(state, move_id, net, _tensor_shared, _context);
+
+			return values;
+		}
+
+		net.evaluate_afterstates(state, _batch_evaluator);
+		return refine_afterstate_values(state, net, _batch_evaluator.values());
+	}
+
+	const std::vector<double>& TdLambdaSubAgent::refine_afterstate_values(const IMinimalStateReadonly& state,
+		const INet& net, std::vector<double>& values)
+	{
+		thread_local std::vector<int> ids_sorted;
+		thread_local std::vector<bool> refine;
+		ids_sorted.clear();
+		refine.assign(values.size(), false);
+
+		for (auto move_id = 0; move_id < static_cast<int>(values.size()); ++move_id)
+		{
+			if (std::isnan(values[move_id]))
+				refine[move_id] = true;
+			else
+				ids_sorted.push_back(move_id);
+		}
+
+		std::ranges::sort(ids_sorted, [&values](const auto a, const auto b) { return values[a] < values[b]; });
+
+		for (auto item_id = 1ull; item_id < ids_sorted.size(); ++item_id)
+		{
+			const auto id_prev = ids_sorted[item_id - 1];
+			const auto id = ids_sorted[item_id];
+
+			if (values[id] - values[id_prev] <= BatchComparisonTolerance * (1.0 + std::abs(values[id])))
+				refine[id_prev] = refine[id] = true;
+		}
+
+		for (auto move_id = 0; move_id < static_cast<int>(values.size()); ++move_id)
+		{
+			if (refine[move_id])
+				values[move_id] = evaluate(state, move_id, net, _tensor_shared, _context);
+		}
+
+		return values;
 	}
 
 	MoveData TdLambdaSubAgent::evaluate(const IMinimalStateReadonly& state,
 	                                    const int move_id, const INet& net)
 	{
 		const auto value = evaluate(state, move_id, net, _tensor_shared, _context);
-		return { move_id,  value, _tensor_shared };
+		return { move_id,  value };
 	}
 
 	double TdLambdaSubAgent::evaluate(const IMinimalStateReadonly& state, const int move_id,
 		const INet& net, DeepLearning::CpuDC::tensor_t& afterstate,
 		DeepLearning::Net<DeepLearning::CpuDC>::Context& comp_context)
 	{
-		const auto afterstate_std = state.evaluate(move_id);
-		net.evaluate(afterstate_std, afterstate, comp_context);
-		return comp_context.get_out()[0];
+		state.evaluate(move_id, _state_vector_shared);
+		const auto cache_ptr = net.value_cache();
+
+		if (cache_ptr == nullptr)
+			return net.evaluate(_state_vector_shared, afterstate, comp_context);
+
+		const auto hash = AfterstateValueCache::calc_hash(_state_vector_shared);
+		double value;
+
+		if (!cache_ptr->try_get(hash, value))
+		{
+			value = net.evaluate(_state_vector_shared, afterstate, comp_context);
+			cache_ptr->put(hash, value);
+		}
+
+		return value;
 	}
 
-	double TdLambdaSubAgent::update_z_and_evaluate_prev_after_state(const ITdlSettingsReadOnly& settings, INet& net)
+	void TdLambdaSubAgent::update_net(const double target_value, const ITdlSettingsReadOnly& settings, INet& net)
 	{
-		const auto lambda_times_gamma = settings.get_lambda() * settings.get_discount();
-		net.calc_gradient_and_value(_prev_after_state, _tensor_shared, DeepLearning::CostFunctionId::LINEAR,
-			_z, _tensor_shared, lambda_times_gamma, _context);
+		const auto trace_decay = _reset_traces ? 0.0 : settings.get_lambda() * settings.get_discount();
+		_reset_traces = false;
+
+		const auto value = _use_traces ?
+			net.td_lambda_update(_prev_after_state, target_value, settings.get_learning_rate(), trace_decay, _z) :
+			net.td_zero_update(_prev_after_state, target_value, settings.get_learning_rate());
 
-		return _tensor_shared[0];
+		if (const auto buffer_ptr = net.replay_buffer(); buffer_ptr != nullptr)
+			buffer_ptr->add(_prev_after_state, value, target_value, net, settings.get_learning_rate());
+	}
+
+	void TdLambdaSubAgent::assign_prev_after_state(const IMinimalStateReadonly& state, const int move_id, const INet& net)
+	{
+		state.evaluate(move_id, _state_vector_shared);
+		net.convert(_state_vector_shared, _prev_after_state);
+	}
+
+	void TdLambdaSubAgent::append_episode_after_state(const IMinimalStateReadonly& state, const int move_id, const INet& net)
+	{
+		if (static_cast<int>(_episode_after_states.size()) <= _episode_length)
+		{
+			_episode_after_states.resize(_episode_length + 1);
+			_episode_rewards.resize(_episode_length + 1);
+		}
+
+		state.evaluate(move_id, _state_vector_shared);
+		net.convert(_state_vector_shared, _episode_after_states[_episode_length]);
+		_episode_rewards[_episode_length] = 0.0;
+		++_episode_length;
 	}
 
 	void TdLambdaSubAgent::reset()
@@ -137,6 +296,11 @@ namespace TrainingCell
 	TdLambdaSubAgent::TdLambdaSubAgent(const bool is_white) : _is_white(is_white)
 	{}
 
+	TdLambdaSubAgent::~TdLambdaSubAgent()
+	{
+		EligibilityTracePool::release(_z);
+	}
+
 	int TdLambdaSubAgent::make_move(const IMinimalStateReadonly& state,
 	                                const ITdlSettingsReadOnly& settings, INet& net)
 	{
@@ -155,28 +319,62 @@ namespace TrainingCell
 
 		if (_new_game)
 		{
-			_prev_after_state = std::move(move_data.after_state);
-			_prev_state = state.evaluate();
+			state.evaluate(_prev_state);
 			_new_game = false;
-			net.allocate(_z, /*assign zero*/ true);
+			_episode_batched = settings.get_episode_batched_training();
+
+			if (_episode_batched)
+			{
+				_episode_length = 0;
+				append_episode_after_state(state, move_data.move_id, net);
+				return move_data.move_id;
+			}
+
+			assign_prev_after_state(state, move_data.move_id, net);
+			_use_traces = settings.get_lambda() != 0.0;
+
+			if (_use_traces)
+			{
+				if (!net.is_compatible(_z))
+					EligibilityTracePool::acquire(net, _z);
+
+				_reset_traces = true;
+			}
+
 			return move_data.move_id;
 		}
 
-		auto current_state_tensor = state.evaluate();
+		state.evaluate(_current_state);
 		const auto reward = settings.get_reward_factor() <= 0.0 ? 0.0 : settings.get_reward_factor() *
-			state.calc_reward(_prev_state, current_state_tensor);
+			state.calc_reward(_prev_state, _current_state);
 
-		const auto prev_afterstate_value = update_z_and_evaluate_prev_after_state(settings, net);
-		const auto delta = reward + settings.get_discount() * move_data.value - prev_afterstate_value;
+		if (_episode_batched)
+		{
+			_episode_rewards[_episode_length - 1] = reward;
+			append_episode_after_state(state, move_data.move_id, net);
+			std::swap(_prev_state, _current_state);
+			return move_data.move_id;
+		}
 
-		net.update(_z, -settings.get_learning_rate() * delta, 0.0);
+		update_net(reward + settings.get_discount() * move_data.value, settings, net);
 
-		_prev_after_state = std::move(move_data.after_state);
-		_prev_state = std::move(current_state_tensor);
+		assign_prev_after_state(state, move_data.move_id, net);
+		std::swap(_prev_state, _current_state);
 
 		return move_data.move_id;
 	}
 
+	CoTask<int> TdLambdaSubAgent::make_move(const IMinimalStateReadonly& state, const ITdlSettingsReadOnly& settings,
+		INet& net, EvaluationScheduler& scheduler)
+	{
+		// a single move is picked without evaluating anything in bulk
+		if (state.get_moves_count() > 1)
+			co_await scheduler.evaluate_afterstates(net, state, _afterstate_values);
+
+		auto move_data = pick_move(state, _afterstate_values, settings, net);
+		co_return make_move(state, std::move(move_data), settings, net);
+	}
+
 	void TdLambdaSubAgent::game_over(const IMinimalStateReadonly& final_state, const GameResult& result,
 		const ITdlSettingsReadOnly& settings, INet& net)
 	{
@@ -186,13 +384,44 @@ namespace TrainingCell
 			const auto discount_factor = moves_to_discount <= 0 ? 1.0 : pow(settings.get_discount(), moves_to_discount);
 
 			const auto reward = 2 * static_cast<int>(result) * discount_factor;
-			const auto delta = reward - update_z_and_evaluate_prev_after_state(settings, net);
-			net.update(_z, -settings.get_learning_rate() * delta, 0.0);
+
+			if (_episode_batched)
+			{
+				_episode_rewards[_episode_length - 1] = reward;
+				net.td_lambda_return_update(_episode_after_states, _episode_rewards, _episode_length,
+					settings.get_learning_rate(), settings.get_discount(), settings.get_lambda());
+			}
+			else
+				update_net(reward, settings, net);
 		}
 
 		reset();
 	}
 
+	MoveData TdLambdaSubAgent::pick_move(const IMinimalStateReadonly& state, std::vector<double>& afterstate_values,
+		const ITdlSettingsReadOnly& settings, const INet& net) const
+	{
+		if (state.get_moves_count() == 1)
+			return evaluate(state, 0, net);
+
+		if (static_cast<int>(afterstate_values.size()) != state.get_moves_count())
+			throw std::exception("Unexpected number of afterstate values");
+
+		if (should_do_exploration(settings))
+		{
+			const auto actual_exploration_volume = std::min(settings.get_exploration_volume(), state.get_moves_count());
+			const auto picked_move_id = Explorer::pick(actual_exploration_volume);
+
+			if (actual_exploration_volume == state.get_moves_count())
+				return evaluate(state, picked_move_id, net);
+
+			return explore(state, net, actual_exploration_volume, picked_move_id,
+				refine_afterstate_values(state, net, afterstate_values));
+		}
+
+		return pick_move(state, net, refine_afterstate_values(state, net, afterstate_values));
+	}
+
 	int TdLambdaSubAgent::pick_move_id(const IMinimalStateReadonly& state,
 	                                   const ITdlSettingsReadOnly& settings, const INet& net) const
 	{
@@ -201,7 +430,7 @@ namespace TrainingCell
 
 	bool TdLambdaSubAgent::equal(const TdLambdaSubAgent& another_sub_agent) const
 	{
-		return _z == another_sub_agent._z &&
+		return equal_traces(_z, _reset_traces, another_sub_agent._z, another_sub_agent._reset_traces) &&
 			_prev_state == another_sub_agent._prev_state &&
 			_prev_after_state == another_sub_agent._prev_after_state;
 	}
@@ -214,7 +443,13 @@ namespace TrainingCell
 	void TdLambdaSubAgent::free_mem()
 	{
 		_z.clear();
+		_prev_state = std::vector<int>();
+		_current_state = std::vector<int>();
 		_prev_after_state = DeepLearning::CpuDC::tensor_t();
+		_episode_after_states = std::vector<DeepLearning::CpuDC::tensor_t>();
+		_episode_rewards = std::vector<double>();
+		_episode_length = 0;
+		_afterstate_values = std::vector<double>();
 		reset();
 	}
 }
@@ -21,9 +21,12 @@
 #include "../Headers/Board.h"
 #include <nlohmann/json.hpp>
 #include "../Headers/StateTypeController.h"
+#include "../Headers/EligibilityTracePool.h"
 
 namespace TrainingCell
 {
+	thread_local EvaluationScheduler TdlAbstractAgent::_search_scheduler{};
+
 	bool TdlAbstractAgent::get_training_mode(const bool as_white) const
 	{
 		const auto sub_mode = training_sub_mode();
@@ -36,6 +39,8 @@ namespace TrainingCell
 
 	DeepLearning::Net<DeepLearning::CpuDC>& TdlAbstractAgent::net()
 	{
+		// the method is called on each weight update (potentially from many threads at once), so that
+		// the quantized snapshot and the cached values are refreshed when training is over (see "on_training_finished()")
 		return _net;
 	}
 
@@ -49,6 +54,25 @@ namespace TrainingCell
 		return _converter;
 	}
 
+	AfterstateValueCache* TdlAbstractAgent::value_cache() const
+	{
+		if (!_value_cache.is_enabled() || get_training_mode())
+			return nullptr;
+
+		return &_value_cache;
+	}
+
+	ReplayBuffer* TdlAbstractAgent::replay_buffer()
+	{
+		if (_replay_capacity <= 0 || !get_training_mode())
+			return nullptr;
+
+		if (!_replay_buffer.has_configuration(_replay_capacity, _replay_batch_size, _replay_interval, _replay_prioritized))
+			_replay_buffer = ReplayBuffer(_replay_capacity, _replay_batch_size, _replay_interval, _replay_prioritized);
+
+		return &_replay_buffer;
+	}
+
 	AutoTrainingSubMode TdlAbstractAgent::training_sub_mode() const
 	{
 		return _performance_evaluation_mode ? AutoTrainingSubMode::NONE : _training_sub_mode;
@@ -63,6 +87,8 @@ namespace TrainingCell
 		activ_func_ids.rbegin()[0] = DeepLearning::ActivationFunctionId::LINEAR;
 
 		_net = DeepLearning::Net(layer_dimensions, activ_func_ids);
+		update_quantized_net();
+		_value_cache.invalidate();
 	}
 
 	const char* json_agent_type_id = "AgentType";
@@ -71,6 +97,11 @@ namespace TrainingCell
 	const char* json_lambda_id = "Lambda";
 	const char* json_discount_id = "Discount";
 	const char* json_learning_rate_id = "LearnRate";
+	const char* json_replay_capacity_id = "ReplayCapacity";
+	const char* json_replay_batch_size_id = "ReplayBatchSize";
+	const char* json_replay_interval_id = "ReplayInterval";
+	const char* json_replay_prioritized_id = "ReplayPrioritized";
+	const char* json_episode_batched_training_id = "EpisodeBatchedTraining";
 	const char* json_exploration_rate_id = "Exploration";
 	const char* json_training_mode_id = "TrainingMode";
 	const char* json_reward_factor_id = "RewardFactor";
@@ -132,6 +163,21 @@ namespace TrainingCell
 		if (json.contains(json_learning_rate_id))
 			_alpha = json[json_learning_rate_id].get<double>();
 
+		if (json.contains(json_replay_capacity_id))
+			_replay_capacity = json[json_replay_capacity_id].get<int>();
+
+		if (json.contains(json_replay_batch_size_id))
+			_replay_batch_size = json[json_replay_batch_size_id].get<int>();
+
+		if (json.contains(json_replay_interval_id))
+			_replay_interval = json[json_replay_interval_id].get<int>();
+
+		if (json.contains(json_replay_prioritized_id))
+			_replay_prioritized = json[json_replay_prioritized_id].get<bool>();
+
+		if (json.contains(json_episode_batched_training_id))
+			_episode_batched_training = json[json_episode_batched_training_id].get<bool>();
+
 		if (json.contains(json_exploration_rate_id))
 			_exploration_epsilon = json[json_exploration_rate_id].get<double>();
 
@@ -163,6 +209,7 @@ namespace TrainingCell
 			_performance_evaluation_mode = json[json_performance_evaluation_mode_id].get<bool>();
 
 		validate();
+		update_quantized_net();
 	}
 
 	std::string TdlAbstractAgent::to_script() const
@@ -174,6 +221,11 @@ namespace TrainingCell
 		json[json_lambda_id] = _lambda;
 		json[json_discount_id] = _gamma;
 		json[json_learning_rate_id] = _alpha;
+		json[json_replay_capacity_id] = _replay_capacity;
+		json[json_replay_batch_size_id] = _replay_batch_size;
+		json[json_replay_interval_id] = _replay_interval;
+		json[json_replay_prioritized_id] = _replay_prioritized;
+		json[json_episode_batched_training_id] = _episode_batched_training;
 		json[json_exploration_rate_id] = _exploration_epsilon;
 		json[json_training_mode_id] = _training_sub_mode;
 		json[json_reward_factor_id] = _reward_factor;
@@ -198,6 +250,11 @@ namespace TrainingCell
 			_lambda == anotherAgent._lambda &&
 			_gamma == anotherAgent._gamma &&
 			_alpha == anotherAgent._alpha &&
+			_replay_capacity == anotherAgent._replay_capacity &&
+			_replay_batch_size == anotherAgent._replay_batch_size &&
+			_replay_interval == anotherAgent._replay_interval &&
+			_replay_prioritized == anotherAgent._replay_prioritized &&
+			_episode_batched_training == anotherAgent._episode_batched_training &&
 			_reward_factor == anotherAgent._reward_factor &&
 			_search_method == anotherAgent._search_method &&
 			_td_search_iterations == anotherAgent._td_search_iterations &&
@@ -235,6 +292,16 @@ namespace TrainingCell
 
 	int TdlAbstractAgent::make_move(const IStateReadOnly& state, const bool as_white)
 	{
+		if (use_quantized_net())
+		{
+			// the snapshot gets reset each time the net can get modified
+			if (!_quantized_net)
+				update_quantized_net();
+
+			// there is no training in the performance evaluation mode, so that sub-agents can be bypassed
+			return _quantized_net->pick_move(state).move_id;
+		}
+
 		if (_search_method == TreeSearchMethod::TD_SEARCH)
 		{
 			auto move_data = run_search(state);
@@ -250,6 +317,15 @@ namespace TrainingCell
 		return _sub_agents[as_white].make_move(state, *this, *this);
 	}
 
+	CoTask<int> TdlAbstractAgent::make_move_async(const IStateReadOnly& state, const bool as_white,
+		EvaluationScheduler& scheduler)
+	{
+		if (use_quantized_net() || _search_method == TreeSearchMethod::TD_SEARCH)
+			co_return make_move(state, as_white);
+
+		co_return co_await _sub_agents[as_white].make_move(state, *this, *this, scheduler);
+	}
+
 	void TdlAbstractAgent::game_over(const IStateReadOnly& final_state, const GameResult& result, const bool as_white)
 	{
 		if (_search_method != TreeSearchMethod::NONE)
@@ -261,6 +337,11 @@ namespace TrainingCell
 
 	int TdlAbstractAgent::pick_move_id(const IStateReadOnly& state, const bool as_white) const
 	{
+		// the snapshot is not (re)built here, so that the method can be called concurrently;
+		// if it is outdated, the full-precision net is used
+		if (use_quantized_net() && _quantized_net)
+			return _quantized_net->pick_move(state).move_id;
+
 		if (_search_method == TreeSearchMethod::TD_SEARCH)
 			return run_search(state).move_id;
 
@@ -299,7 +380,11 @@ namespace TrainingCell
 
 	void TdlAbstractAgent::set_training_mode(const bool training_mode)
 	{
+		const auto was_training = get_training_mode();
 		_training_sub_mode = training_mode_to_sub_mode(training_mode);
+
+		if (was_training && !get_training_mode())
+			on_training_finished();
 	}
 
 	bool TdlAbstractAgent::get_training_mode() const
@@ -309,7 +394,11 @@ namespace TrainingCell
 
 	void TdlAbstractAgent::set_training_sub_mode(const AutoTrainingSubMode sub_mode)
 	{
+		const auto was_training = get_training_mode();
 		_training_sub_mode = sub_mode;
+
+		if (was_training && !get_training_mode())
+			on_training_finished();
 	}
 
 	void TdlAbstractAgent::set_reward_factor(const double reward_factor)
@@ -322,9 +411,59 @@ namespace TrainingCell
 		return _reward_factor;
 	}
 
+	void TdlAbstractAgent::set_replay_capacity(const int capacity)
+	{
+		if (capacity < 0)
+			throw std::exception("Invalid capacity of the replay buffer");
+
+		_replay_capacity = capacity;
+	}
+
+	int TdlAbstractAgent::get_replay_capacity() const
+	{
+		return _replay_capacity;
+	}
+
+	void TdlAbstractAgent::set_replay_batch_size(const int batch_size)
+	{
+		if (batch_size <= 0)
+			throw std::exception("Invalid size of a replay mini-batch");
+
+		_replay_batch_size = batch_size;
+	}
+
+	int TdlAbstractAgent::get_replay_batch_size() const
+	{
+		return _replay_batch_size;
+	}
+
+	void TdlAbstractAgent::set_replay_interval(const int interval)
+	{
+		if (interval <= 0)
+			throw std::exception("Invalid replay interval");
+
+		_replay_interval = interval;
+	}
+
+	int TdlAbstractAgent::get_replay_interval() const
+	{
+		return _replay_interval;
+	}
+
+	void TdlAbstractAgent::set_replay_prioritized(const bool prioritized)
+	{
+		_replay_prioritized = prioritized;
+	}
+
+	bool TdlAbstractAgent::get_replay_prioritized() const
+	{
+		return _replay_prioritized;
+	}
+
 	void TdlAbstractAgent::set_tree_search_method(const TreeSearchMethod search_method)
 	{
 		_search_method = search_method;
+		update_quantized_net();
 	}
 
 	TreeSearchMethod TdlAbstractAgent::get_tree_search_method() const
@@ -360,6 +499,29 @@ namespace TrainingCell
 		return std::numeric_limits<int>::max();
 	}
 
+	bool TdlAbstractAgent::get_episode_batched_training() const
+	{
+		return _episode_batched_training;
+	}
+
+	void TdlAbstractAgent::set_episode_batched_training(const bool value)
+	{
+		_episode_batched_training = value;
+	}
+
+	void TdlAbstractAgent::set_td_search_games(const int games_cnt)
+	{
+		if (games_cnt <= 0)
+			throw std::exception("Invalid number of search games");
+
+		_td_search_games = games_cnt;
+	}
+
+	int TdlAbstractAgent::get_td_search_games() const
+	{
+		return _td_search_games;
+	}
+
 	int TdlAbstractAgent::get_search_depth() const
 	{
 		return _td_search_depth;
@@ -407,7 +569,13 @@ namespace TrainingCell
 
 	void TdlAbstractAgent::set_performance_evaluation_mode(const bool value)
 	{
+		const auto was_training = get_training_mode();
 		_performance_evaluation_mode = value;
+
+		if (was_training && !get_training_mode())
+			on_training_finished();
+		else
+			update_quantized_net();
 	}
 
 	bool TdlAbstractAgent::get_performance_evaluation_mode() const
@@ -415,6 +583,73 @@ namespace TrainingCell
 		return _performance_evaluation_mode;
 	}
 
+	void TdlAbstractAgent::set_sparse_input_mode(const bool value)
+	{
+		set_sparse_input(value);
+		// values calculated in different modes can differ within round-off error
+		_value_cache.invalidate();
+	}
+
+	bool TdlAbstractAgent::get_sparse_input_mode() const
+	{
+		return get_sparse_input();
+	}
+
+	void TdlAbstractAgent::set_quantized_inference_mode(const bool value)
+	{
+		_quantized_inference_mode = value;
+		update_quantized_net();
+	}
+
+	bool TdlAbstractAgent::get_quantized_inference_mode() const
+	{
+		return _quantized_inference_mode;
+	}
+
+	void TdlAbstractAgent::set_value_cache_capacity(const std::size_t capacity)
+	{
+		_value_cache.set_capacity(capacity);
+	}
+
+	std::size_t TdlAbstractAgent::get_value_cache_capacity() const
+	{
+		return _value_cache.get_capacity();
+	}
+
+	bool TdlAbstractAgent::use_quantized_net() const
+	{
+		return _quantized_inference_mode && _performance_evaluation_mode && _search_method == TreeSearchMethod::NONE;
+	}
+
+	void TdlAbstractAgent::update_quantized_net()
+	{
+		if (use_quantized_net())
+			_quantized_net.emplace(_net, _converter);
+		else
+			_quantized_net.reset();
+	}
+
+	void TdlAbstractAgent::on_training_finished()
+	{
+		update_quantized_net();
+		_value_cache.invalidate();
+	}
+
+	TdlTrainingAdapter TdlAbstractAgent::create_training_adapter()
+	{
+		return TdlTrainingAdapter(this, TdlSettings(*this), _state_type_id);
+	}
+
+	TdlLearner TdlAbstractAgent::create_learner()
+	{
+		return TdlLearner(this, TdlSettings(*this));
+	}
+
+	TdlLockstepEnvironment TdlAbstractAgent::create_lockstep_environment(const int games_cnt, const int max_moves_without_capture)
+	{
+		return TdlLockstepEnvironment(this, TdlSettings(*this), _state_type_id, games_cnt, max_moves_without_capture);
+	}
+
 	void TdlAbstractAgent::reset_explorer(const unsigned seed)
 	{
 		TdLambdaSubAgent::reset_explorer(seed);
@@ -424,6 +659,7 @@ namespace TrainingCell
 	{
 		_sub_agents[false].free_mem();
 		_sub_agents[true].free_mem();
+		EligibilityTracePool::clear();
 	}
 
 	void TdlAbstractAgent::set_lambda(const double lambda)
@@ -476,11 +712,33 @@ namespace TrainingCell
 	MoveData TdlAbstractAgent::run_search(const IStateReadOnly& state) const
 	{
 		if (!_search_net)
+		{
 			_search_net = std::make_optional(NetWithConverter(_net, _converter)); // copy the current net if search net is not defined
+			_search_net->set_sparse_input(get_sparse_input());
+		}
+
+		if (_td_search_games > 1)
+		{
+			const auto search_settings = get_search_settings();
+			std::vector<TdlTrainingAdapter> adapters;
+			adapters.reserve(_td_search_games);
+			std::vector<std::array<IMinimalAgent*, 2>> agent_pairs;
 
-		TdlTrainingAdapter adapter(&_search_net.value(), get_search_settings(), _state_type_id);
-		Board::play(&adapter, &adapter,_td_search_iterations,
-			state.current_state_seed(), 100 /*max moves without capture for a draw*/);
+			for (auto game_id = 0; game_id < _td_search_games; ++game_id)
+			{
+				auto& adapter = adapters.emplace_back(&_search_net.value(), search_settings, _state_type_id);
+				agent_pairs.push_back({ &adapter, &adapter });
+			}
+
+			Board::play(agent_pairs, _td_search_iterations, state.current_state_seed(),
+				100 /*max moves without capture for a draw*/, _search_scheduler);
+		}
+		else
+		{
+			TdlTrainingAdapter adapter(&_search_net.value(), get_search_settings(), _state_type_id);
+			Board::play(&adapter, &adapter,_td_search_iterations,
+				state.current_state_seed(), 100 /*max moves without capture for a draw*/);
+		}
 
 		return TdLambdaSubAgent::pick_move(state, _search_net.value());
 	}
@@ -489,6 +747,9 @@ namespace TrainingCell
 	{
 		if (!validate_net_input_size(StateTypeController::get_state_size(_state_type_id)))
 			throw std::exception("Neural net is incompatible with the chosen state type");
+
+		if (_replay_capacity < 0 || _replay_batch_size <= 0 || _replay_interval <= 0)
+			throw std::exception("Invalid parameters of experience replay");
 	}
 
 	StateConversionType to_state_conversion_type(const StateTypeId state_type_id)
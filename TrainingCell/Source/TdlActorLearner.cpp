@@ -0,0 +1,173 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "../Headers/TdlActorLearner.h"
+#include "../Headers/StateTypeController.h"
+#include <cmath>
+#include <thread>
+
+namespace TrainingCell
+{
+	TdlActor::TdlActor(const TdlSettings& settings, const StateTypeId state_type_id, const int actor_id,
+		TdlExperienceQueue& queue, const TdlNetSnapshotSlot& snapshot_slot) :
+		_settings(settings), _acting_settings(settings), _state_type_id(state_type_id),
+		_actor_id(actor_id), _queue(queue), _snapshot_slot(snapshot_slot)
+	{
+		if (_actor_id < 0)
+			throw std::exception("Invalid actor ID");
+
+		_snapshot = _snapshot_slot.load();
+
+		if (!_snapshot)
+			throw std::exception("Invalid snapshot of the neural network");
+
+		if (!_snapshot->validate_net_input_size(StateTypeController::get_state_size(_state_type_id)))
+			throw std::exception("Net is incompatible with the suggested state type.");
+
+		_acting_settings.set_training_mode(false, /*as white*/ true);
+		_acting_settings.set_training_mode(false, /*as white*/ false);
+	}
+
+	void TdlActor::push_record()
+	{
+		while (!_queue.try_push(_record))
+			std::this_thread::yield();
+	}
+
+	bool TdlActor::is_trainable(const int move_number, const bool as_white) const
+	{
+		return _settings.get_training_mode(as_white) && move_number <= _settings.get_train_depth();
+	}
+
+	int TdlActor::make_move(const IStateReadOnly& state, const bool as_white)
+	{
+		const auto move_id = _sub_agents[as_white].make_move(state, _acting_settings, *_snapshot);
+		const auto move_number = ++_move_counter[as_white];
+
+		if (!is_trainable(move_number, as_white))
+			return move_id;
+
+		auto& prev_state = _prev_state[as_white];
+
+		if (move_number == 1)
+		{
+			state.evaluate(prev_state);
+			_record.reward = 0.0;
+		}
+		else
+		{
+			state.evaluate(_current_state);
+			_record.reward = _settings.get_reward_factor() <= 0.0 ? 0.0 : _settings.get_reward_factor() *
+				state.calc_reward(prev_state, _current_state);
+			std::swap(prev_state, _current_state);
+		}
+
+		state.evaluate(move_id, _record.afterstate);
+		_record.terminal = false;
+		_record.chain_id = 2 * _actor_id + as_white;
+		push_record();
+
+		return move_id;
+	}
+
+	void TdlActor::game_over(const IStateReadOnly& final_state, const GameResult& result, const bool as_white)
+	{
+		if (_settings.get_training_mode(as_white) && _move_counter[as_white] > 0)
+		{
+			const auto moves_to_discount = _move_counter[as_white] - _settings.get_train_depth();
+			const auto discount_factor = moves_to_discount <= 0 ? 1.0 : pow(_settings.get_discount(), moves_to_discount);
+
+			_record.afterstate.clear();
+			_record.reward = 2 * static_cast<int>(result) * discount_factor;
+			_record.terminal = true;
+			_record.chain_id = 2 * _actor_id + as_white;
+			push_record();
+		}
+
+		_move_counter[as_white] = 0;
+		_sub_agents[as_white].game_over(final_state, result, _acting_settings, *_snapshot);
+		_snapshot = _snapshot_slot.load();
+	}
+
+	StateTypeId TdlActor::get_state_type_id() const
+	{
+		return _state_type_id;
+	}
+
+	TdlLearner::TdlLearner(INet* net_ptr, const TdlSettings& settings) : _net_ptr(net_ptr), _settings(settings)
+	{
+		if (!_net_ptr)
+			throw std::exception("Invalid pointer to the neural network");
+	}
+
+	void TdlLearner::update_net(Chain& chain, const double target_value)
+	{
+		if (chain.z.empty())
+		{
+			_net_ptr->td_zero_update(chain.prev_after_state, target_value, _settings.get_learning_rate());
+			return;
+		}
+
+		const auto trace_decay = chain.reset_z ? 0.0 : _settings.get_lambda() * _settings.get_discount();
+		chain.reset_z = false;
+		_net_ptr->td_lambda_update(chain.prev_after_state, target_value, _settings.get_learning_rate(),
+			trace_decay, chain.z);
+	}
+
+	void TdlLearner::process(const TdlExperienceRecord& record)
+	{
+		if (record.chain_id < 0)
+			throw std::exception("Invalid chain ID");
+
+		if (record.chain_id >= static_cast<int>(_chains.size()))
+			_chains.resize(record.chain_id + 1);
+
+		auto& chain = _chains[record.chain_id];
+
+		if (record.terminal)
+		{
+			if (chain.active)
+				update_net(chain, record.reward);
+
+			chain.active = false;
+			return;
+		}
+
+		if (!chain.active)
+		{
+			_net_ptr->convert(record.afterstate, chain.prev_after_state);
+			chain.active = true;
+
+			if (_settings.get_lambda() != 0.0)
+			{
+				if (!_net_ptr->is_compatible(chain.z))
+					_net_ptr->allocate(chain.z, /*assign zero*/ true);
+
+				chain.reset_z = true;
+			}
+			else
+				chain.z.clear();
+
+			return;
+		}
+
+		// the value of the next afterstate is calculated with the current weights (not with those of the snapshot the actor used)
+		const auto next_value = _net_ptr->evaluate(record.afterstate, _after_state, _context);
+		update_net(chain, record.reward + _settings.get_discount() * next_value);
+		std::swap(chain.prev_after_state, _after_state);
+	}
+}
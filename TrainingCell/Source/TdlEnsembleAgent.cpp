@@ -84,6 +84,10 @@ namespace TrainingCell
 		agent.set_tree_search_method(_search_method);
 		agent.set_td_search_iterations(_search_iterations);
 		agent.set_performance_evaluation_mode(true);
+		agent.set_quantized_inference_mode(_quantized_inference);
+
+		if (agent.get_value_cache_capacity() != _value_cache_capacity)
+			agent.set_value_cache_capacity(_value_cache_capacity);
 	}
 
 	void TdlEnsembleAgent::synchronize_parameters()
@@ -329,4 +333,26 @@ namespace TrainingCell
 	{
 		_run_multi_threaded = run_multi_threaded;
 	}
+
+	bool TdlEnsembleAgent::get_quantized_inference() const
+	{
+		return _quantized_inference;
+	}
+
+	void TdlEnsembleAgent::set_quantized_inference(const bool quantized_inference)
+	{
+		_quantized_inference = quantized_inference;
+		synchronize_parameters();
+	}
+
+	std::size_t TdlEnsembleAgent::get_value_cache_capacity() const
+	{
+		return _value_cache_capacity;
+	}
+
+	void TdlEnsembleAgent::set_value_cache_capacity(const std::size_t capacity)
+	{
+		_value_cache_capacity = capacity;
+		synchronize_parameters();
+	}
 }
@@ -0,0 +1,43 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#include "../Headers/TdlLockstepEnvironment.h"
+#include "../Headers/StateTypeController.h"
+
+namespace TrainingCell
+{
+	TdlLockstepEnvironment::TdlLockstepEnvironment(INet* net_ptr, const TdlSettings& settings, const StateTypeId state_type_id,
+		const int games_cnt, const int max_moves_without_capture) :
+		_start_seed(StateTypeController::get_start_seed(state_type_id)),
+		_max_moves_without_capture(max_moves_without_capture)
+	{
+		if (games_cnt <= 0)
+			throw std::exception("Invalid number of games");
+
+		_adapters.reserve(games_cnt);
+
+		for (auto game_id = 0; game_id < games_cnt; ++game_id)
+			_adapters.emplace_back(net_ptr, settings, state_type_id);
+
+		for (auto& adapter : _adapters)
+			_agent_pairs.push_back({ &adapter, &adapter });
+	}
+
+	Board::Stats TdlLockstepEnvironment::run(const int episodes)
+	{
+		return Board::play(_agent_pairs, episodes, *_start_seed, _max_moves_without_capture, _scheduler);
+	}
+}
@@ -34,6 +34,7 @@ namespace TrainingCell
 		_train_depth = settings.get_train_depth();
 		_exploration_depth = settings.get_exploration_depth();
 		_exploration_volume = settings.get_exploration_volume();
+		_episode_batched_training = settings.get_episode_batched_training();
 	}
 
 	double TdlSettings::get_exploration_probability() const
@@ -129,6 +130,16 @@ namespace TrainingCell
 		_exploration_volume = volume;
 	}
 
+	bool TdlSettings::get_episode_batched_training() const
+	{
+		return _episode_batched_training;
+	}
+
+	void TdlSettings::set_episode_batched_training(const bool episode_batched_training)
+	{
+		_episode_batched_training = episode_batched_training;
+	}
+
 	bool TdlSettings::operator==(const TdlSettings& otherSettings) const
 	{
 		return _exploration_probability == otherSettings._exploration_probability &&
@@ -140,6 +151,7 @@ namespace TrainingCell
 			   _reward_factor == otherSettings._reward_factor &&
 			   _train_depth == otherSettings._train_depth &&
 			   _exploration_depth == otherSettings._exploration_depth &&
-			   _exploration_volume == otherSettings._exploration_volume;
+			   _exploration_volume == otherSettings._exploration_volume &&
+			   _episode_batched_training == otherSettings._episode_batched_training;
 	}
 }
@@ -35,6 +35,12 @@ namespace TrainingCell
 		return _sub_agents[as_white].make_move(state, _settings, *_net_ptr);
 	}
 
+	CoTask<int> TdlTrainingAdapter::make_move_async(const IStateReadOnly& state, const bool as_white,
+		EvaluationScheduler& scheduler)
+	{
+		co_return co_await _sub_agents[as_white].make_move(state, _settings, *_net_ptr, scheduler);
+	}
+
 	void TdlTrainingAdapter::game_over(const IStateReadOnly& final_state, const GameResult& result, const bool as_white)
 	{
 		_sub_agents[as_white].game_over(final_state, result, _settings, *_net_ptr);
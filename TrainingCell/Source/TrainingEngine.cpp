@@ -23,6 +23,9 @@
 #include "../Headers/StateTypeController.h"
 #include <numeric>
 #include <ppl.h>
+#include <atomic>
+#include <thread>
+#include <exception>
 
 namespace TrainingCell
 {
@@ -145,8 +148,11 @@ namespace TrainingCell
 					auto agent_black_ptr = _agent_pointers[black_agent_id];
 
 					auto state_seed_ptr = StateTypeController::get_start_seed(agent_white_ptr->get_state_type_id());
+					const auto single_pass = agent_white_ptr->get_tree_search_method() == TreeSearchMethod::NONE &&
+						agent_black_ptr->get_tree_search_method() == TreeSearchMethod::NONE;
 					const auto stats = smart_training ?
-						Board::train(agent_white_ptr, agent_black_ptr, training_episodes_cnt, *state_seed_ptr, _max_moves_without_capture) :
+						Board::train(agent_white_ptr, agent_black_ptr, training_episodes_cnt, *state_seed_ptr, _max_moves_without_capture,
+							Board::DefaultMaxConsequentDrawEpisodes, nullptr, nullptr, nullptr, single_pass) :
 						Board::play(agent_white_ptr, agent_black_ptr, training_episodes_cnt, *state_seed_ptr, _max_moves_without_capture);
 					const auto draw_percentage = (training_episodes_cnt - stats.blacks_win_count() - stats.whites_win_count()) * 1.0 / training_episodes_cnt;
 
@@ -185,8 +191,10 @@ namespace TrainingCell
 			{
 				const auto agent_ptr = _agent_pointers[agent_id];
 			    auto state_seed_ptr = StateTypeController::get_start_seed(agent_ptr->get_state_type_id());
+				const auto single_pass = agent_ptr->get_tree_search_method() == TreeSearchMethod::NONE;
 				const auto stats = smart_training ?
-					Board::train(agent_ptr, agent_ptr, training_episodes_cnt, *state_seed_ptr, _max_moves_without_capture) :
+					Board::train(agent_ptr, agent_ptr, training_episodes_cnt, *state_seed_ptr, _max_moves_without_capture,
+						Board::DefaultMaxConsequentDrawEpisodes, nullptr, nullptr, nullptr, single_pass) :
 					Board::play(agent_ptr, agent_ptr, training_episodes_cnt, *state_seed_ptr, _max_moves_without_capture);
 				const auto draw_percentage = (training_episodes_cnt - stats.blacks_win_count() - stats.whites_win_count()) * 1.0 / training_episodes_cnt;
 				performance_scores[agent_id] = evaluate_performance(*agent_ptr, training_episodes_cnt, test_episodes_cnt, round_id, draw_percentage);
@@ -199,6 +207,222 @@ namespace TrainingCell
 		}
 	}
 
+	Board::Stats TrainingEngine::train_hogwild(TdLambdaAgent& agent, const int episodes, const int threads_cnt)
+	{
+		if (threads_cnt <= 0)
+			throw std::exception("Invalid number of threads");
+
+		if (agent.get_replay_capacity() > 0)
+			throw std::exception("Experience replay is not supported in Hogwild training");
+
+		std::atomic<int> blacks_win_count{};
+		std::atomic<int> whites_win_count{};
+
+		Concurrency::parallel_for(0, threads_cnt, [&agent, &blacks_win_count, &whites_win_count, episodes, threads_cnt](const auto thread_id)
+			{
+				// otherwise exploration moves in different threads might be the same
+				TdLambdaSubAgent::reset_explorer();
+
+				auto adapter = agent.create_training_adapter();
+				const auto thread_episodes = episodes / threads_cnt + (thread_id < episodes % threads_cnt ? 1 : 0);
+				const auto state_seed_ptr = StateTypeController::get_start_seed(agent.get_state_type_id());
+				const auto stats = Board::play(&adapter, &adapter, thread_episodes, *state_seed_ptr, _max_moves_without_capture);
+
+				blacks_win_count += stats.blacks_win_count();
+				whites_win_count += stats.whites_win_count();
+			});
+
+		return { blacks_win_count, whites_win_count, episodes };
+	}
+
+	void TrainingEngine::run_auto_sequential(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+		const std::function<void(const long long& time_per_round_ms, const std::vector<PerformanceRec>&
+			agent_performances)>& round_callback, const std::function<Board::Stats(TdLambdaAgent& agent)>& trainer,
+		const int test_episodes_cnt, const bool remove_outliers) const
+	{
+		if (_agent_pointers.empty())
+			throw std::exception("Collection of agents must be nonempty");
+
+		std::vector<PerformanceRec> performance_scores(_agent_pointers.size());
+		std::vector<double> draw_percentages(_agent_pointers.size());
+
+		for (auto round_id = round_id_start; round_id < max_round_id; round_id++)
+		{
+			DeepLearning::StopWatch sw;
+
+			for (auto agent_id = 0ull; agent_id < _agent_pointers.size(); ++agent_id)
+			{
+				const auto stats = trainer(*_agent_pointers[agent_id]);
+				draw_percentages[agent_id] = (training_episodes_cnt - stats.blacks_win_count() - stats.whites_win_count()) * 1.0 / training_episodes_cnt;
+			}
+
+			Concurrency::parallel_for(0ull, _agent_pointers.size(),
+				[this, &performance_scores, &draw_percentages, training_episodes_cnt, test_episodes_cnt, round_id](const auto& agent_id)
+				{
+					performance_scores[agent_id] = evaluate_performance(*_agent_pointers[agent_id], training_episodes_cnt,
+						test_episodes_cnt, round_id, draw_percentages[agent_id]);
+				});
+
+			round_callback(sw.elapsed_time_in_milliseconds(), performance_scores);
+
+			if (remove_outliers)
+				remove_low_score_outliers(performance_scores, _agent_pointers);
+		}
+	}
+
+	void TrainingEngine::run_auto_hogwild(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+		const std::function<void(const long long& time_per_round_ms, const std::vector<PerformanceRec>&
+			agent_performances)>& round_callback, const int threads_cnt, const int test_episodes_cnt,
+		const bool remove_outliers) const
+	{
+		run_auto_sequential(round_id_start, max_round_id, training_episodes_cnt, round_callback,
+			[training_episodes_cnt, threads_cnt](TdLambdaAgent& agent)
+			{
+				return train_hogwild(agent, training_episodes_cnt, threads_cnt);
+			}, test_episodes_cnt, remove_outliers);
+	}
+
+	Board::Stats TrainingEngine::train_actor_learner(TdLambdaAgent& agent, const int episodes, const int actors_cnt,
+		const int snapshot_refresh_interval)
+	{
+		if (actors_cnt <= 0)
+			throw std::exception("Invalid number of actors");
+
+		if (snapshot_refresh_interval <= 0)
+			throw std::exception("Invalid snapshot refresh interval");
+
+		if (agent.get_replay_capacity() > 0)
+			throw std::exception("Experience replay is not supported in actor-learner training");
+
+		TdlExperienceQueue queue(_actor_learner_queue_capacity);
+		TdlNetSnapshotSlot snapshot_slot(std::make_shared<NetWithConverter>(agent.create_net_copy<NetWithConverter>()));
+		const TdlSettings settings(agent);
+		const auto state_type_id = agent.get_state_type_id();
+
+		std::atomic<int> blacks_win_count{};
+		std::atomic<int> whites_win_count{};
+		std::atomic<int> running_actors_cnt{ actors_cnt };
+		std::vector<std::exception_ptr> actor_exceptions(actors_cnt);
+		std::vector<std::thread> actors;
+
+		for (auto actor_id = 0; actor_id < actors_cnt; ++actor_id)
+			actors.emplace_back([&, actor_id]()
+				{
+					try
+					{
+						// otherwise exploration moves in different threads might be the same
+						TdLambdaSubAgent::reset_explorer();
+
+						TdlActor actor(settings, state_type_id, actor_id, queue, snapshot_slot);
+						const auto actor_episodes = episodes / actors_cnt + (actor_id < episodes % actors_cnt ? 1 : 0);
+						const auto state_seed_ptr = StateTypeController::get_start_seed(state_type_id);
+						const auto stats = Board::play(&actor, &actor, actor_episodes, *state_seed_ptr, _max_moves_without_capture);
+
+						blacks_win_count += stats.blacks_win_count();
+						whites_win_count += stats.whites_win_count();
+					} catch (...)
+					{
+						actor_exceptions[actor_id] = std::current_exception();
+					}
+
+					--running_actors_cnt;
+				});
+
+		auto learner = agent.create_learner();
+		std::exception_ptr learner_exception{};
+		TdlExperienceRecord record{};
+		auto processed_records_cnt = 0ll;
+
+		while (true)
+		{
+			// read before trying to pop, so that failure to pop means that all the records have been consumed
+			const auto actors_finished = running_actors_cnt.load() == 0;
+
+			if (!queue.try_pop(record))
+			{
+				if (actors_finished)
+					break;
+
+				std::this_thread::yield();
+				continue;
+			}
+
+			// after a failure the learner keeps consuming (and discarding) records, so that actors do not get blocked
+			if (learner_exception)
+				continue;
+
+			try
+			{
+				learner.process(record);
+
+				if (++processed_records_cnt % snapshot_refresh_interval == 0)
+					snapshot_slot.store(std::make_shared<NetWithConverter>(agent.create_net_copy<NetWithConverter>()));
+			} catch (...)
+			{
+				learner_exception = std::current_exception();
+			}
+		}
+
+		for (auto& actor : actors)
+			actor.join();
+
+		if (learner_exception)
+			std::rethrow_exception(learner_exception);
+
+		for (const auto& actor_exception : actor_exceptions)
+			if (actor_exception)
+				std::rethrow_exception(actor_exception);
+
+		return { blacks_win_count, whites_win_count, episodes };
+	}
+
+	void TrainingEngine::run_auto_actor_learner(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+		const std::function<void(const long long& time_per_round_ms, const std::vector<PerformanceRec>&
+			agent_performances)>& round_callback, const int actors_cnt, const int snapshot_refresh_interval,
+		const int test_episodes_cnt, const bool remove_outliers) const
+	{
+		run_auto_sequential(round_id_start, max_round_id, training_episodes_cnt, round_callback,
+			[training_episodes_cnt, actors_cnt, snapshot_refresh_interval](TdLambdaAgent& agent)
+			{
+				return train_actor_learner(agent, training_episodes_cnt, actors_cnt, snapshot_refresh_interval);
+			}, test_episodes_cnt, remove_outliers);
+	}
+
+	Board::Stats TrainingEngine::train_lockstep(TdLambdaAgent& agent, const int episodes, const int games_cnt)
+	{
+		auto environment = agent.create_lockstep_environment(games_cnt, _max_moves_without_capture);
+		return environment.run(episodes);
+	}
+
+	void TrainingEngine::run_auto_lockstep(const int round_id_start, const int max_round_id, const int training_episodes_cnt,
+		const std::function<void(const long long& time_per_round_ms, const std::vector<PerformanceRec>&
+			agent_performances)>& round_callback, const int games_cnt, const int test_episodes_cnt,
+		const bool remove_outliers) const
+	{
+		if (_agent_pointers.empty())
+			throw std::exception("Collection of agents must be nonempty");
+
+		std::vector<PerformanceRec> performance_scores(_agent_pointers.size());
+
+		for (auto round_id = round_id_start; round_id < max_round_id; round_id++)
+		{
+			DeepLearning::StopWatch sw;
+			Concurrency::parallel_for(0ull, _agent_pointers.size(),
+				[this, &performance_scores, training_episodes_cnt, test_episodes_cnt, round_id, games_cnt](const auto& agent_id)
+			{
+				const auto agent_ptr = _agent_pointers[agent_id];
+				const auto stats = train_lockstep(*agent_ptr, training_episodes_cnt, games_cnt);
+				const auto draw_percentage = (training_episodes_cnt - stats.blacks_win_count() - stats.whites_win_count()) * 1.0 / training_episodes_cnt;
+				performance_scores[agent_id] = evaluate_performance(*agent_ptr, training_episodes_cnt, test_episodes_cnt, round_id, draw_percentage);
+			});
+
+			round_callback(sw.elapsed_time_in_milliseconds(), performance_scores);
+
+			if (remove_outliers)
+				remove_low_score_outliers(performance_scores, _agent_pointers);
+		}
+	}
+
 	double TrainingEngine::PerformanceRec::get_score() const
 	{
 		return 0.5 * (perf_white + perf_black);
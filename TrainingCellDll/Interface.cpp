@@ -356,6 +356,60 @@ bool TdLambdaAgentSetPerformanceEvaluationMode(TrainingCell::TdLambdaAgent* agen
 	return true;
 }
 
+char TdLambdaAgentGetQuantizedInferenceMode(TrainingCell::TdLambdaAgent* agent_ptr)
+{
+	if (!agent_ptr)
+		return static_cast<char>(2);
+
+	return static_cast<char>(agent_ptr->get_quantized_inference_mode());
+}
+
+bool TdLambdaAgentSetQuantizedInferenceMode(TrainingCell::TdLambdaAgent* agent_ptr, const bool mode)
+{
+	if (!agent_ptr)
+		return false;
+
+	agent_ptr->set_quantized_inference_mode(mode);
+
+	return true;
+}
+
+long long TdLambdaAgentGetValueCacheCapacity(TrainingCell::TdLambdaAgent* agent_ptr)
+{
+	if (!agent_ptr)
+		return -1;
+
+	return static_cast<long long>(agent_ptr->get_value_cache_capacity());
+}
+
+bool TdLambdaAgentSetValueCacheCapacity(TrainingCell::TdLambdaAgent* agent_ptr, const unsigned int capacity)
+{
+	if (!agent_ptr)
+		return false;
+
+	agent_ptr->set_value_cache_capacity(capacity);
+
+	return true;
+}
+
+char TdLambdaAgentGetEpisodeBatchedTraining(TrainingCell::TdLambdaAgent* agent_ptr)
+{
+	if (!agent_ptr)
+		return static_cast<char>(2);
+
+	return static_cast<char>(agent_ptr->get_episode_batched_training());
+}
+
+bool TdLambdaAgentSetEpisodeBatchedTraining(TrainingCell::TdLambdaAgent* agent_ptr, const bool mode)
+{
+	if (!agent_ptr)
+		return false;
+
+	agent_ptr->set_episode_batched_training(mode);
+
+	return true;
+}
+
 bool TdLambdaAgentSetRewardFactor(TrainingCell::TdLambdaAgent* agent_ptr, const double reward_factor)
 {
 	if (!agent_ptr)
@@ -861,6 +915,24 @@ TRAINING_CELL_API bool TdlEnsembleAgentSetRunMultiThreaded(TrainingCell::TdlEnse
 
 	return true;
 }
+
+char TdlEnsembleAgentGetQuantizedInference(const TrainingCell::TdlEnsembleAgent* agent_ptr)
+{
+	if (!agent_ptr)
+		return 2;
+
+	return static_cast<char>(agent_ptr->get_quantized_inference());
+}
+
+TRAINING_CELL_API bool TdlEnsembleAgentSetQuantizedInference(TrainingCell::TdlEnsembleAgent* agent_ptr, const bool quantized_inference)
+{
+	if (!agent_ptr)
+		return false;
+
+	agent_ptr->set_quantized_inference(quantized_inference);
+
+	return true;
+}
 #pragma endregion TdlEnsembleAgent
 
 #pragma region StateEditor
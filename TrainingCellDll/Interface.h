@@ -312,6 +312,42 @@ extern "C"
 	/// </summary>
 	TRAINING_CELL_API bool TdLambdaAgentSetPerformanceEvaluationMode(TrainingCell::TdLambdaAgent* agent_ptr, const bool mode);
 
+	/// <summary>
+	/// Returns value of "quantized inference mode" flag.
+	/// Returned value other than "0" or "1" indicates an error.
+	/// </summary>
+	TRAINING_CELL_API char TdLambdaAgentGetQuantizedInferenceMode(TrainingCell::TdLambdaAgent* agent_ptr);
+
+	/// <summary>
+	/// Sets value of "quantized inference mode" flag.
+	/// Returns "true" if succeeded.
+	/// </summary>
+	TRAINING_CELL_API bool TdLambdaAgentSetQuantizedInferenceMode(TrainingCell::TdLambdaAgent* agent_ptr, const bool mode);
+
+	/// <summary>
+	/// Returns capacity of the afterstate value cache of the given agent (zero means that the cache is disabled).
+	/// Negative returned value indicates an error.
+	/// </summary>
+	TRAINING_CELL_API long long TdLambdaAgentGetValueCacheCapacity(TrainingCell::TdLambdaAgent* agent_ptr);
+
+	/// <summary>
+	/// Sets capacity of the afterstate value cache of the given agent (zero disables the cache).
+	/// Returns "true" if succeeded.
+	/// </summary>
+	TRAINING_CELL_API bool TdLambdaAgentSetValueCacheCapacity(TrainingCell::TdLambdaAgent* agent_ptr, const unsigned int capacity);
+
+	/// <summary>
+	/// Returns value of "episode-batched training" flag.
+	/// Returned value other than "0" or "1" indicates an error.
+	/// </summary>
+	TRAINING_CELL_API char TdLambdaAgentGetEpisodeBatchedTraining(TrainingCell::TdLambdaAgent* agent_ptr);
+
+	/// <summary>
+	/// Sets value of "episode-batched training" flag.
+	/// Returns "true" if succeeded.
+	/// </summary>
+	TRAINING_CELL_API bool TdLambdaAgentSetEpisodeBatchedTraining(TrainingCell::TdLambdaAgent* agent_ptr, const bool mode);
+
 	/// <summary>
 	/// An interface method to get script-string representation of the given agent represented with its pointer.
 	/// </summary>
@@ -585,6 +621,18 @@ extern "C"
 	/// Returns "true" if succeeded.
 	/// </summary>
 	TRAINING_CELL_API bool TdlEnsembleAgentSetRunMultiThreaded(TrainingCell::TdlEnsembleAgent* agent_ptr, const bool run_multi_threaded);
+
+	/// <summary>
+	/// Returns value of "quantized inference" property of the given ensemble agent (a boolean value encoded as char,
+	/// value other than 0 or 1 indicates an error).
+	/// </summary>
+	TRAINING_CELL_API char TdlEnsembleAgentGetQuantizedInference(const TrainingCell::TdlEnsembleAgent* agent_ptr);
+
+	/// <summary>
+	/// Updates "quantized inference" property of the given ensemble agent with the given value.
+	/// Returns "true" if succeeded.
+	/// </summary>
+	TRAINING_CELL_API bool TdlEnsembleAgentSetQuantizedInference(TrainingCell::TdlEnsembleAgent* agent_ptr, const bool quantized_inference);
 #pragma endregion TdlEnsembleAgent
 
 #pragma region StateEditor
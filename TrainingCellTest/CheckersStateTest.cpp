@@ -21,6 +21,7 @@
 #include "../TrainingCell/Headers/Move.h"
 #include "../TrainingCell/Headers/Checkers/CheckersMove.h"
 #include "../DeepLearning/DeepLearning/MsgPackUtils.h"
+#include "../DeepLearning/DeepLearning/Utilities.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace TrainingCell;
@@ -206,5 +207,64 @@ namespace TrainingCellTest
 			run_checkers_move_to_general_move_conversion_test(gen_move);
 		}
 
+		/// <summary>
+		/// Asserts that the "bitboard" move generator returns exactly the same moves
+		/// (in exactly the same order) as the "reference" one for the given state.
+		/// </summary>
+		static void assert_bitboard_moves(const CheckersState& state)
+		{
+			CheckersState::MoveList reference_moves;
+			state.get_moves_reference(reference_moves);
+
+			CheckersState::MoveList moves;
+			state.get_moves(moves);
+
+			Assert::IsTrue(reference_moves == moves, L"Bitboard generator returned unexpected moves");
+		}
+
+		TEST_METHOD(BitboardMoveGenerationTest)
+		{
+			constexpr auto episodes_count = 1000;
+			constexpr auto max_moves_count = 300;
+			auto captures_count = 0;
+
+			for (auto episode_id = 0; episode_id < episodes_count; ++episode_id)
+			{
+				// Arrange
+				auto state = CheckersState::get_start_state();
+
+				// odd episodes start from a random arrangement of pieces (including kings)
+				if (episode_id % 2 == 1)
+				{
+					static const std::vector pieces = { Piece::Space, Piece::Space, Piece::Space, Piece::Man,
+						Piece::King, Piece::AntiMan, Piece::AntiKing };
+
+					for (auto field_id = 0; field_id < StateSize; ++field_id)
+						state[field_id] = pieces[DeepLearning::Utils::get_random_int(0, static_cast<int>(pieces.size() - 1))];
+
+					// men can't reside on the last row
+					for (auto field_id = StateSize - FieldsInRow; field_id < StateSize; ++field_id)
+						if (state[field_id] == Piece::Man)
+							state[field_id] = Piece::King;
+				}
+
+				for (auto move_id = 0; move_id < max_moves_count; ++move_id)
+				{
+					// Act and assert
+					assert_bitboard_moves(state);
+
+					const auto moves = state.get_moves();
+
+					if (moves.empty())
+						break;
+
+					captures_count += moves[0].to_move().sub_moves[0].capture.is_valid();
+					state.make_move_and_invert(moves[DeepLearning::Utils::get_random_int(0, static_cast<int>(moves.size() - 1))]);
+				}
+			}
+
+			// Sanity check
+			Assert::IsTrue(captures_count > 0, L"Capturing moves were not covered");
+		}
 	};
 }
@@ -17,9 +17,13 @@
 
 #include "CppUnitTest.h"
 #include "../TrainingCell/Headers/Chess/ChessState.h"
+#include "../TrainingCell/Headers/Chess/PieceController.h"
+#include "../TrainingCell/Headers/Chess/PosController.h"
+#include "../TrainingCell/Headers/Move.h"
 #include "../DeepLearning/DeepLearning/Utilities.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace TrainingCell;
 using namespace TrainingCell::Chess;
 
 namespace TrainingCellTest
@@ -33,7 +37,7 @@ namespace TrainingCellTest
 			constexpr auto episodes_to_play = 500;
 
 			// Act
-			std::vector<ChessMove> available_moves;
+			ChessState::MoveList available_moves;
 			int castling_moves_executed = 0;
 			int stalemates = 0;
 			int checkmates = 0;
@@ -118,5 +122,29 @@ namespace TrainingCellTest
 					state.invert();
 				});
 		}
+
+		TEST_METHOD(CheckCanNotBeBlockedByMovingThroughRivalPieceTest)
+		{
+			// Arrange
+			std::vector board(Checkerboard::FieldsCount, PieceController::Space);
+			const auto king_pos = PiecePosition{ 1, 1 };
+			board[PosController::to_linear(king_pos)] = PieceController::King;
+			board[PosController::to_linear({ 1, 3 })] = PieceController::Rook;
+			// blocks the way of the ally rook to field (3, 3)
+			board[PosController::to_linear({ 2, 3 })] = PieceController::Rook | PieceController::AntiPieceFlag;
+			// gives check along the diagonal passing through field (3, 3)
+			board[PosController::to_linear({ 4, 4 })] = PieceController::Bishop | PieceController::AntiPieceFlag;
+			board[PosController::to_linear({ 7, 7 })] = PieceController::King | PieceController::AntiPieceFlag;
+			const ChessState state(board);
+
+			// Act
+			const auto moves = state.get_moves();
+
+			// Assert
+			Assert::IsFalse(moves.empty(), L"The king is supposed to have moves");
+
+			for (const auto& move : moves)
+				Assert::IsTrue(move.to_move().sub_moves[0].start == king_pos, L"Only the king is supposed to be able to move");
+		}
 	};
 }
@@ -37,9 +37,7 @@ namespace TrainingCellTest
 			auto counter = 0;
 			while (temp_result.size() < samples_count)
 			{
-				MoveData sample(counter++,
-					DeepLearning::Utils::get_random(-10, 10), DeepLearning::Tensor(10, 3, 15));
-				sample.after_state.standard_random_fill();
+				MoveData sample(counter++, DeepLearning::Utils::get_random(-10, 10));
 				temp_result[sample.value] = sample;
 			}
 
@@ -68,7 +66,7 @@ namespace TrainingCellTest
 
 			// Act
 			for (const auto& sample : samples)
-				collector.add(sample.move_id, sample.value, sample.after_state);
+				collector.add(sample.move_id, sample.value);
 
 			// Assert
 			Assert::IsTrue(collector.get_elements_count() == samples_to_collect, L"Unexpected number of collected elements.");
@@ -0,0 +1,695 @@
+//Copyright (c) 2024 Denys Dragunov, dragunovdenis@gmail.com
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files(the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//copies of the Software, and to permit persons to whom the Software is furnished
+//to do so, subject to the following conditions :
+
+//The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "CppUnitTest.h"
+#include "../TrainingCell/Headers/NetWithConverter.h"
+#include "../TrainingCell/Headers/QuantizedNet.h"
+#include "../TrainingCell/Headers/FixedTopologyNet.h"
+#include "../TrainingCell/Headers/BatchNetTrainer.h"
+#include "../TrainingCell/Headers/StateTypeController.h"
+#include "../TrainingCell/Headers/TdLambdaSubAgent.h"
+#include "../TrainingCell/Headers/TdLambdaAgent.h"
+#include "../TrainingCell/Headers/IState.h"
+#include "../TrainingCell/Headers/EligibilityTracePool.h"
+#include <random>
+#include <limits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace TrainingCell;
+
+namespace TrainingCellTest
+{
+	TEST_CLASS(NetEvaluationTest)
+	{
+		/// <summary>
+		/// Returns state converter suitable for the given state type.
+		/// </summary>
+		static StateConverter get_converter(const StateTypeId state_type_id)
+		{
+			return StateConverter(state_type_id == StateTypeId::CHESS ?
+				StateConversionType::ChessStandard : StateConversionType::CheckersStandard);
+		}
+
+		/// <summary>
+		/// Returns randomly initialized net suitable for the given state type.
+		/// </summary>
+		static DeepLearning::Net<DeepLearning::CpuDC> construct_plain_net(const StateTypeId state_type_id)
+		{
+			const auto input_size = NetWithConverterAbstract::calc_input_net_size(
+				StateTypeController::get_state_size(state_type_id), get_converter(state_type_id));
+
+			return DeepLearning::Net<DeepLearning::CpuDC>({ input_size, 64, 32, 1 },
+				{ DeepLearning::ActivationFunctionId::RELU,
+				DeepLearning::ActivationFunctionId::RELU,
+				DeepLearning::ActivationFunctionId::LINEAR });
+		}
+
+		/// <summary>
+		/// Returns randomly initialized net with converter suitable for the given state type.
+		/// </summary>
+		static NetWithConverter construct_net(const StateTypeId state_type_id)
+		{
+			return NetWithConverter(construct_plain_net(state_type_id), get_converter(state_type_id));
+		}
+
+		/// <summary>
+		/// Returns state of the given type obtained from the start state by applying the given number of random moves.
+		/// </summary>
+		static std::unique_ptr<IState> get_random_state(const StateTypeId state_type_id, const int moves_count)
+		{
+			std::mt19937 generator(static_cast<unsigned int>(moves_count));
+			auto state = StateTypeController::get_start_seed(state_type_id)->yield(false);
+
+			for (auto move_id = 0; move_id < moves_count && state->get_moves_count() > 1; ++move_id)
+				state->move_invert_reset(std::uniform_int_distribution(0, state->get_moves_count() - 1)(generator));
+
+			return state;
+		}
+
+		/// <summary>
+		/// General method to test that batched evaluation of afterstates is consistent with the regular one.
+		/// </summary>
+		static void check_batched_evaluation(const StateTypeId state_type_id, const FirstLayerMode first_layer_mode)
+		{
+			// Arrange
+			const auto net = construct_net(state_type_id);
+			DeepLearning::CpuDC::tensor_t afterstate;
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			BatchNetEvaluator evaluator;
+			evaluator.set_first_layer_mode(first_layer_mode);
+
+			for (auto moves_count = 0; moves_count < 10; ++moves_count)
+			{
+				const auto state = get_random_state(state_type_id, moves_count);
+
+				// Act
+				net.evaluate_afterstates(*state, evaluator);
+
+				// Assert
+				const auto& values = evaluator.values();
+				Assert::AreEqual(static_cast<std::size_t>(state->get_moves_count()), values.size(), L"Unexpected number of values.");
+
+				auto best_move_id = -1;
+				auto best_value = -std::numeric_limits<double>::max();
+
+				for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+				{
+					const auto value_reference = net.evaluate(state->evaluate(move_id), afterstate, context);
+					const auto diff = std::abs(value_reference - values[move_id]);
+					Assert::IsTrue(diff < 1e-5 * (1 + std::abs(value_reference)),
+						L"Too big deviation from the reference value.");
+
+					if (value_reference > best_value)
+					{
+						best_value = value_reference;
+						best_move_id = move_id;
+					}
+				}
+
+				const auto move_data = TdLambdaSubAgent::pick_move(*state, net);
+				Assert::AreEqual(best_move_id, move_data.move_id, L"Unexpected move picked.");
+				Assert::AreEqual(best_value, move_data.value, L"Unexpected value of the picked move.");
+			}
+		}
+
+		/// <summary>
+		/// General method to test that batched evaluation of afterstates of several states is consistent with the regular one.
+		/// </summary>
+		static void check_multi_state_batched_evaluation(const StateTypeId state_type_id, const FirstLayerMode first_layer_mode)
+		{
+			// Arrange
+			const auto net = construct_net(state_type_id);
+			DeepLearning::CpuDC::tensor_t afterstate;
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			BatchNetEvaluator evaluator;
+			evaluator.set_first_layer_mode(first_layer_mode);
+
+			std::vector<std::unique_ptr<IState>> states;
+			std::vector<const IMinimalStateReadonly*> state_pointers;
+
+			for (auto moves_count = 0; moves_count < 10; ++moves_count)
+			{
+				states.push_back(get_random_state(state_type_id, moves_count));
+				state_pointers.push_back(states.rbegin()->get());
+			}
+
+			// Act
+			net.evaluate_afterstates(state_pointers, evaluator);
+
+			// Assert
+			const auto& values = evaluator.values();
+			auto item_id = 0ull;
+
+			for (const auto& state : states)
+			{
+				for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id, ++item_id)
+				{
+					Assert::IsTrue(item_id < values.size(), L"Too few values.");
+					const auto value_reference = net.evaluate(state->evaluate(move_id), afterstate, context);
+					const auto diff = std::abs(value_reference - values[item_id]);
+					Assert::IsTrue(diff < 1e-5 * (1 + std::abs(value_reference)),
+						L"Too big deviation from the reference value.");
+				}
+			}
+
+			Assert::AreEqual(item_id, values.size(), L"Unexpected number of values.");
+		}
+
+		/// <summary>
+		/// Returns maximal absolute difference between the corresponding elements of the given tensors.
+		/// </summary>
+		static double max_abs_diff(const DeepLearning::CpuDC::tensor_t& a, const DeepLearning::CpuDC::tensor_t& b)
+		{
+			Assert::AreEqual(a.size(), b.size(), L"Tensors must be of the same size.");
+			double result = 0;
+
+			for (auto element_id = 0ull; element_id < a.size(); ++element_id)
+				result = std::max(result, static_cast<double>(std::abs(a[element_id] - b[element_id])));
+
+			return result;
+		}
+
+		/// <summary>
+		/// General method to test that the "sparse input" mode is consistent with the regular one.
+		/// </summary>
+		static void check_sparse_input_mode(const StateTypeId state_type_id)
+		{
+			// Arrange
+			auto net = construct_net(state_type_id);
+			const auto state = get_random_state(state_type_id, 7);
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			DeepLearning::CpuDC::tensor_t afterstate;
+			const DeepLearning::CpuDC::tensor_t target(1, 1, 1);
+			constexpr double tolerance = 1e-5;
+
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> gradient_reference;
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> gradient_sparse;
+			net.allocate(gradient_reference, true);
+			net.allocate(gradient_sparse, true);
+			DeepLearning::CpuDC::tensor_t value_reference;
+			DeepLearning::CpuDC::tensor_t value_sparse;
+
+			for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+			{
+				const auto afterstate_vector = state->evaluate(move_id);
+
+				// Act
+				net.set_sparse_input(false);
+				const auto afterstate_value_reference = net.evaluate(afterstate_vector, afterstate, context);
+				net.calc_gradient_and_value(afterstate, target, DeepLearning::CostFunctionId::LINEAR,
+					gradient_reference, value_reference, 0.7, context);
+
+				net.set_sparse_input(true);
+				const auto afterstate_value_sparse = net.evaluate(afterstate_vector, afterstate, context);
+				net.calc_gradient_and_value(afterstate, target, DeepLearning::CostFunctionId::LINEAR,
+					gradient_sparse, value_sparse, 0.7, context);
+
+				// Assert
+				Assert::IsTrue(std::abs(afterstate_value_reference - afterstate_value_sparse) < tolerance,
+					L"Too big deviation of the value.");
+				Assert::IsTrue(max_abs_diff(value_reference, value_sparse) < tolerance,
+					L"Too big deviation of the value calculated together with gradient.");
+
+				for (auto layer_id = 0ull; layer_id < gradient_reference.size(); ++layer_id)
+				{
+					Assert::IsTrue(max_abs_diff(gradient_reference[layer_id].Biases_grad,
+						gradient_sparse[layer_id].Biases_grad) < tolerance, L"Too big deviation of bias gradient.");
+					Assert::IsTrue(max_abs_diff(gradient_reference[layer_id].Weights_grad[0],
+						gradient_sparse[layer_id].Weights_grad[0]) < tolerance, L"Too big deviation of weight gradient.");
+				}
+			}
+		}
+
+		/// <summary>
+		/// General method to test that the quantized snapshot of a net approximates the original net well enough.
+		/// </summary>
+		static void check_quantized_evaluation(const StateTypeId state_type_id)
+		{
+			// Arrange
+			const auto plain_net = construct_plain_net(state_type_id);
+			const NetWithConverter net(plain_net, get_converter(state_type_id));
+			DeepLearning::CpuDC::tensor_t afterstate;
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			constexpr double tolerance = 5e-2;
+
+			// Act
+			const QuantizedNet quantized_net(plain_net, get_converter(state_type_id));
+
+			// Assert
+			for (auto moves_count = 0; moves_count < 10; ++moves_count)
+			{
+				const auto state = get_random_state(state_type_id, moves_count);
+				auto max_value = -std::numeric_limits<double>::max();
+
+				for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+				{
+					const auto afterstate_vector = state->evaluate(move_id);
+					const auto reference_value = net.evaluate(afterstate_vector, afterstate, context);
+					const auto quantized_value = quantized_net.evaluate(afterstate_vector);
+
+					Assert::IsTrue(std::abs(reference_value - quantized_value) <= tolerance * (1.0 + std::abs(reference_value)),
+						L"Too big deviation of the quantized value.");
+
+					max_value = std::max(max_value, reference_value);
+				}
+
+				const auto [picked_move_id, picked_value] = quantized_net.pick_move(*state);
+				const auto picked_reference_value = net.evaluate(state->evaluate(picked_move_id), afterstate, context);
+
+				Assert::IsTrue(max_value - picked_reference_value <= 2 * tolerance * (1.0 + std::abs(max_value)),
+					L"The picked move is too far from the optimal one.");
+			}
+		}
+
+		TEST_METHOD(QuantizedEvaluationCheckersTest)
+		{
+			check_quantized_evaluation(StateTypeId::CHECKERS);
+		}
+
+		TEST_METHOD(QuantizedEvaluationChessTest)
+		{
+			check_quantized_evaluation(StateTypeId::CHESS);
+		}
+
+		TEST_METHOD(AfterstateValueCacheTest)
+		{
+			// Arrange
+			AfterstateValueCache cache(100);
+			const auto state = get_random_state(StateTypeId::CHESS, 5);
+			const auto hash = AfterstateValueCache::calc_hash(state->evaluate(0));
+			const auto another_hash = AfterstateValueCache::calc_hash(state->evaluate(1));
+			double value{};
+
+			// Act
+			cache.put(hash, 0.25);
+
+			// Assert
+			Assert::AreEqual(128ull, cache.get_capacity(), L"Unexpected capacity.");
+			Assert::AreNotEqual(hash, another_hash, L"Different afterstates are expected to have different hashes.");
+			Assert::IsTrue(cache.try_get(hash, value) && value == 0.25, L"The value is expected to be found.");
+			Assert::IsFalse(cache.try_get(another_hash, value), L"The value is not expected to be found.");
+			Assert::IsFalse(AfterstateValueCache(cache).try_get(hash, value), L"Copy of the cache is expected to be empty.");
+
+			cache.invalidate();
+			Assert::IsFalse(cache.try_get(hash, value), L"The cache is expected to be invalidated.");
+		}
+
+		TEST_METHOD(ValueCacheDoesNotAffectMovesTest)
+		{
+			// Arrange
+			TdLambdaAgent agent({ 32, 16 }, 0.0, 0.1, 0.9, 0.01, StateTypeId::CHESS);
+			agent.set_performance_evaluation_mode(true);
+			auto agent_with_cache = agent;
+			agent_with_cache.set_value_cache_capacity(1 << 12);
+
+			for (auto moves_count = 0; moves_count < 10; ++moves_count)
+			{
+				const auto state = get_random_state(StateTypeId::CHESS, moves_count);
+				const auto expected_move_id = agent.pick_move_id(*state, true);
+
+				// Act & Assert (the second pass is supposed to take values from the cache)
+				for (auto pass_id = 0; pass_id < 2; ++pass_id)
+					Assert::AreEqual(expected_move_id, agent_with_cache.pick_move_id(*state, true),
+						L"Moves picked with and without cache differ.");
+			}
+		}
+
+		TEST_METHOD(FixedTopologyNetTest)
+		{
+			// Arrange
+			const TdLambdaAgent agent({ 32, 16, 8 }, 0.0, 0.1, 0.9, 0.01, StateTypeId::CHECKERS);
+			const auto net = agent.create_net_copy<NetWithConverter>();
+			DeepLearning::CpuDC::tensor_t afterstate;
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			BatchNetEvaluator evaluator;
+			constexpr double tolerance = 1e-5;
+
+			// Act
+			const auto fixed_net = agent.create_net_copy<StandardFixedTopologyNet<32, 32, 16, 8, 1>>();
+
+			// Assert
+			for (auto moves_count = 0; moves_count < 10; ++moves_count)
+			{
+				const auto state = get_random_state(StateTypeId::CHECKERS, moves_count);
+				fixed_net.evaluate_afterstates(*state, evaluator);
+
+				for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+				{
+					const auto afterstate_vector = state->evaluate(move_id);
+					const auto reference_value = net.evaluate(afterstate_vector, afterstate, context);
+					const auto fixed_value = fixed_net.evaluate(afterstate_vector, afterstate, context);
+
+					Assert::IsTrue(std::abs(reference_value - fixed_value) <= tolerance * (1.0 + std::abs(reference_value)),
+						L"Too big deviation of the value.");
+					Assert::IsTrue(std::abs(reference_value - evaluator.values()[move_id]) <= tolerance * (1.0 + std::abs(reference_value)),
+						L"Too big deviation of the value evaluated in a batch.");
+				}
+
+				Assert::AreEqual(TdLambdaSubAgent::pick_move(*state, net).move_id,
+					TdLambdaSubAgent::pick_move(*state, fixed_net).move_id, L"Picked moves differ.");
+			}
+
+			Assert::ExpectException<std::exception>([&agent]()
+				{
+					[[maybe_unused]] const auto wrong_net = agent.create_net_copy<StandardFixedTopologyNet<32, 32, 16, 1>>();
+				}, L"Exception is expected for incompatible topology.");
+		}
+
+		/// <summary>
+		/// General method to test that the fused TD(0) update is equivalent to the "gradient + update" one.
+		/// </summary>
+		static void check_td_zero_update(const StateTypeId state_type_id)
+		{
+			// Arrange
+			auto net_reference = construct_net(state_type_id);
+			auto net_fused = net_reference;
+			const auto state = get_random_state(state_type_id, 7);
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			DeepLearning::CpuDC::tensor_t afterstate;
+			const DeepLearning::CpuDC::tensor_t target(1, 1, 1);
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> gradient;
+			net_reference.allocate(gradient, true);
+			DeepLearning::CpuDC::tensor_t value;
+			constexpr double learning_rate = 0.05;
+			constexpr double target_value = 0.75;
+			constexpr double tolerance = 1e-5;
+
+			for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+			{
+				net_reference.convert(state->evaluate(move_id), afterstate);
+
+				// Act
+				net_reference.calc_gradient_and_value(afterstate, target, DeepLearning::CostFunctionId::LINEAR,
+					gradient, value, 0.0, context);
+				net_reference.update(gradient, -learning_rate * (target_value - value[0]), 0.0);
+				const auto value_fused = net_fused.td_zero_update(afterstate, target_value, learning_rate);
+
+				// Assert
+				Assert::IsTrue(std::abs(value[0] - value_fused) < tolerance, L"Values before the update differ.");
+			}
+
+			for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+			{
+				const auto afterstate_vector = state->evaluate(move_id);
+				const auto diff = net_reference.evaluate(afterstate_vector, afterstate, context) -
+					net_fused.evaluate(afterstate_vector, afterstate, context);
+				Assert::IsTrue(std::abs(diff) < tolerance, L"Values after the update differ.");
+			}
+		}
+
+		/// <summary>
+		/// General method to test that the fused TD(lambda) update is equivalent to the regular one.
+		/// </summary>
+		static void check_td_lambda_update(const StateTypeId state_type_id)
+		{
+			// Arrange
+			auto net_reference = construct_net(state_type_id);
+			auto net_fused = net_reference;
+			net_fused.set_sparse_input(true);
+			const auto state = get_random_state(state_type_id, 7);
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			DeepLearning::CpuDC::tensor_t afterstate;
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> traces_reference;
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> traces_fused;
+			net_reference.allocate(traces_reference, true);
+			net_fused.allocate(traces_fused, true);
+			constexpr double learning_rate = 0.05;
+			constexpr double trace_decay = 0.6;
+			constexpr double tolerance = 1e-5;
+
+			for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+			{
+				net_reference.convert(state->evaluate(move_id), afterstate);
+				const auto target_value = 0.1 * move_id;
+
+				// Act
+				const auto value_reference = net_reference.td_lambda_update(afterstate, target_value,
+					learning_rate, trace_decay, traces_reference);
+				const auto value_fused = net_fused.td_lambda_update(afterstate, target_value,
+					learning_rate, trace_decay, traces_fused);
+
+				// Assert
+				Assert::IsTrue(std::abs(value_reference - value_fused) < tolerance, L"Values before the update differ.");
+
+				for (auto layer_id = 0ull; layer_id < traces_reference.size(); ++layer_id)
+				{
+					Assert::IsTrue(max_abs_diff(traces_reference[layer_id].Biases_grad,
+						traces_fused[layer_id].Biases_grad) < tolerance, L"Too big deviation of bias traces.");
+					Assert::IsTrue(max_abs_diff(traces_reference[layer_id].Weights_grad[0],
+						traces_fused[layer_id].Weights_grad[0]) < tolerance, L"Too big deviation of weight traces.");
+				}
+			}
+
+			for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+			{
+				const auto afterstate_vector = state->evaluate(move_id);
+				const auto diff = net_reference.evaluate(afterstate_vector, afterstate, context) -
+					net_fused.evaluate(afterstate_vector, afterstate, context);
+				Assert::IsTrue(std::abs(diff) < tolerance, L"Values after the update differ.");
+			}
+		}
+
+		TEST_METHOD(TdLambdaUpdateCheckersTest)
+		{
+			check_td_lambda_update(StateTypeId::CHECKERS);
+		}
+
+		/// <summary>
+		/// General method to test that the TD(lambda) update with zero trace decay applied to traces
+		/// left from a "previous episode" is equivalent to the regular update with zero-initialized traces.
+		/// </summary>
+		static void check_stale_traces_reset(const StateTypeId state_type_id, const bool sparse_input)
+		{
+			// Arrange
+			auto net_reference = construct_net(state_type_id);
+			net_reference.set_sparse_input(sparse_input);
+			auto net_stale = net_reference;
+			auto net_aux = net_reference;
+			const auto state = get_random_state(state_type_id, 7);
+			DeepLearning::CpuDC::tensor_t afterstate;
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> traces_reference;
+			std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>> traces_stale;
+			net_reference.allocate(traces_reference, true);
+			net_stale.allocate(traces_stale, true);
+			constexpr double learning_rate = 0.05;
+			constexpr double trace_decay = 0.6;
+
+			// fill the traces with "non-trivial" values
+			for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+			{
+				net_aux.convert(state->evaluate(move_id), afterstate);
+				net_aux.td_lambda_update(afterstate, 0.1 * move_id, learning_rate, trace_decay, traces_stale);
+			}
+
+			// a diverged previous owner can leave NaN values in the traces
+			traces_stale[0].Biases_grad.begin()[0] = std::numeric_limits<DeepLearning::Real>::quiet_NaN();
+
+			EligibilityTracePool::release(traces_stale);
+			Assert::IsTrue(traces_stale.empty(), L"Traces were not released.");
+			Assert::IsFalse(EligibilityTracePool::acquire(net_stale, traces_stale), L"Traces were not taken from the pool.");
+			Assert::IsTrue(net_stale.is_compatible(traces_stale), L"Traces are incompatible with the net.");
+
+			for (auto move_id = 0; move_id < state->get_moves_count(); ++move_id)
+			{
+				net_reference.convert(state->evaluate(move_id), afterstate);
+				const auto target_value = 0.1 * move_id;
+
+				// Act
+				const auto value_reference = net_reference.td_lambda_update(afterstate, target_value,
+					learning_rate, trace_decay, traces_reference);
+				const auto value_stale = net_stale.td_lambda_update(afterstate, target_value,
+					learning_rate, move_id == 0 ? 0.0 : trace_decay, traces_stale);
+
+				// Assert
+				Assert::IsTrue(value_reference == value_stale, L"Values before the update differ.");
+
+				for (auto layer_id = 0ull; layer_id < traces_reference.size(); ++layer_id)
+				{
+					Assert::IsTrue(max_abs_diff(traces_reference[layer_id].Biases_grad,
+						traces_stale[layer_id].Biases_grad) == 0.0, L"Bias traces differ.");
+					Assert::IsTrue(max_abs_diff(traces_reference[layer_id].Weights_grad[0],
+						traces_stale[layer_id].Weights_grad[0]) == 0.0, L"Weight traces differ.");
+				}
+			}
+		}
+
+		TEST_METHOD(StaleTracesResetCheckersTest)
+		{
+			check_stale_traces_reset(StateTypeId::CHECKERS, /*sparse input*/ false);
+		}
+
+		TEST_METHOD(StaleTracesResetFusedCheckersTest)
+		{
+			check_stale_traces_reset(StateTypeId::CHECKERS, /*sparse input*/ true);
+		}
+
+		/// <summary>
+		/// General method to test that the mini-batched lambda-return update over an "episode" is equivalent
+		/// to the sum of the regular gradient updates calculated with the weights before the update.
+		/// </summary>
+		static void check_td_lambda_return_update(const StateTypeId state_type_id)
+		{
+			// Arrange
+			auto net_reference = construct_net(state_type_id);
+			auto net_batched = net_reference;
+			const auto state = get_random_state(state_type_id, 7);
+			const auto episode_length = state->get_moves_count();
+			DeepLearning::Net<DeepLearning::CpuDC>::Context context;
+			std::vector<DeepLearning::CpuDC::tensor_t> after_states(episode_length);
+			std::vector<double> rewards(episode_length);
+			std::vector<double> values(episode_length);
+			std::vector<std::vector<DeepLearning::LayerGradient<DeepLearning::CpuDC>>> gradients(episode_length);
+			const DeepLearning::CpuDC::tensor_t target(1, 1, 1);
+			DeepLearning::CpuDC::tensor_t value;
+			constexpr double learning_rate = 0.05;
+			constexpr double discount = 0.9;
+			constexpr double lambda = 0.6;
+			constexpr double tolerance = 1e-5;
+
+			for (auto move_id = 0; move_id < episode_length; ++move_id)
+			{
+				net_reference.convert(state->evaluate(move_id), after_states[move_id]);
+				rewards[move_id] = 0.1 * (move_id % 3) - 0.05;
+				net_reference.allocate(gradients[move_id], true);
+				net_reference.calc_gradient_and_value(after_states[move_id], target, DeepLearning::CostFunctionId::LINEAR,
+					gradients[move_id], value, 0.0, context);
+				values[move_id] = value[0];
+			}
+
+			std::vector<double> returns;
+			BatchNetTrainer::calc_lambda_returns(values, rewards, episode_length, discount, lambda, returns);
+
+			// Act
+			for (auto move_id = 0; move_id < episode_length; ++move_id)
+				net_reference.update(gradients[move_id], -learning_rate * (returns[move_id] - values[move_id]), 0.0);
+
+			net_batched.td_lambda_return_update(after_states, rewards, episode_length, learning_rate, discount, lambda);
+
+			// Assert
+			for (auto move_id = 0; move_id < episode_length; ++move_id)
+			{
+				const auto afterstate_vector = state->evaluate(move_id);
+				const auto diff = net_reference.evaluate(afterstate_vector, after_states[move_id], context) -
+					net_batched.evaluate(afterstate_vector, after_states[move_id], context);
+				Assert::IsTrue(std::abs(diff) < tolerance, L"Values after the update differ.");
+			}
+		}
+
+		TEST_METHOD(LambdaReturnsTest)
+		{
+			// Arrange
+			const std::vector<double> values{ 0.5, -0.25, 0.125, 1.0 };
+			const std::vector<double> rewards{ 0.1, 0.2, -0.3, 2.0 };
+			constexpr double discount = 0.9;
+			std::vector<double> returns_td;
+			std::vector<double> returns_mc;
+
+			// Act
+			BatchNetTrainer::calc_lambda_returns(values, rewards, 4, discount, 0.0, returns_td);
+			BatchNetTrainer::calc_lambda_returns(values, rewards, 4, discount, 1.0, returns_mc);
+
+			// Assert
+			for (auto item_id = 0; item_id < 3; ++item_id)
+				Assert::IsTrue(std::abs(returns_td[item_id] - (rewards[item_id] + discount * values[item_id + 1])) < 1e-12,
+					L"Unexpected one-step return.");
+
+			auto mc_return = rewards[3];
+			for (auto item_id = 3; item_id >= 0; --item_id)
+			{
+				if (item_id < 3)
+					mc_return = rewards[item_id] + discount * mc_return;
+
+				Assert::IsTrue(std::abs(returns_mc[item_id] - mc_return) < 1e-12, L"Unexpected Monte-Carlo return.");
+			}
+		}
+
+		TEST_METHOD(TdLambdaReturnUpdateCheckersTest)
+		{
+			check_td_lambda_return_update(StateTypeId::CHECKERS);
+		}
+
+		TEST_METHOD(TdLambdaReturnUpdateChessTest)
+		{
+			check_td_lambda_return_update(StateTypeId::CHESS);
+		}
+
+		TEST_METHOD(TdLambdaUpdateChessTest)
+		{
+			check_td_lambda_update(StateTypeId::CHESS);
+		}
+
+		TEST_METHOD(TdZeroUpdateCheckersTest)
+		{
+			check_td_zero_update(StateTypeId::CHECKERS);
+		}
+
+		TEST_METHOD(TdZeroUpdateChessTest)
+		{
+			check_td_zero_update(StateTypeId::CHESS);
+		}
+
+		TEST_METHOD(SparseInputModeCheckersTest)
+		{
+			check_sparse_input_mode(StateTypeId::CHECKERS);
+		}
+
+		TEST_METHOD(SparseInputModeChessTest)
+		{
+			check_sparse_input_mode(StateTypeId::CHESS);
+		}
+
+		TEST_METHOD(BatchedEvaluationCheckersTest)
+		{
+			check_batched_evaluation(StateTypeId::CHECKERS, FirstLayerMode::Dense);
+		}
+
+		TEST_METHOD(BatchedEvaluationChessTest)
+		{
+			check_batched_evaluation(StateTypeId::CHESS, FirstLayerMode::Dense);
+		}
+
+		TEST_METHOD(IncrementalEvaluationCheckersTest)
+		{
+			check_batched_evaluation(StateTypeId::CHECKERS, FirstLayerMode::Incremental);
+		}
+
+		TEST_METHOD(IncrementalEvaluationChessTest)
+		{
+			check_batched_evaluation(StateTypeId::CHESS, FirstLayerMode::Incremental);
+		}
+
+		TEST_METHOD(FusedEvaluationCheckersTest)
+		{
+			check_batched_evaluation(StateTypeId::CHECKERS, FirstLayerMode::Fused);
+		}
+
+		TEST_METHOD(FusedEvaluationChessTest)
+		{
+			check_batched_evaluation(StateTypeId::CHESS, FirstLayerMode::Fused);
+		}
+
+		TEST_METHOD(MultiStateBatchedEvaluationCheckersTest)
+		{
+			check_multi_state_batched_evaluation(StateTypeId::CHECKERS, FirstLayerMode::Dense);
+		}
+
+		TEST_METHOD(MultiStateFusedEvaluationChessTest)
+		{
+			check_multi_state_batched_evaluation(StateTypeId::CHESS, FirstLayerMode::Fused);
+		}
+	};
+}
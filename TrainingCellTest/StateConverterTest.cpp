@@ -167,5 +167,73 @@ namespace TrainingCellTest
 					L"Unexpected value of the restored rank");
 			}
 		}
+
+		/// <summary>
+		/// General method to test that conversion into a raw buffer yields the same result as conversion into a tensor.
+		/// </summary>
+		static void check_buffer_conversion(const StateConversionType type)
+		{
+			// Arrange
+			const StateConverter converter(type);
+			constexpr int state_size = 125;
+			const auto input = get_random_state_vector(state_size);
+			DeepLearning::Tensor reference_out;
+			converter.convert(input, reference_out);
+
+			// Act
+			std::vector<DeepLearning::Real> out(state_size * converter.get_expansion_factor());
+			converter.convert(input, out.data());
+
+			// Assert
+			Assert::IsTrue(reference_out.to_stdvector() == out, L"Outputs must be the same");
+		}
+
+		/// <summary>
+		/// General method to test that sparse conversion is consistent with the dense one.
+		/// </summary>
+		static void check_sparse_conversion(const StateConversionType type)
+		{
+			// Arrange
+			const StateConverter converter(type);
+			constexpr int state_size = 125;
+			const auto input = get_random_state_vector(state_size);
+			DeepLearning::Tensor reference_out;
+			converter.convert(input, reference_out);
+
+			// Act
+			SparseState out;
+			converter.convert(input, out);
+
+			// Assert
+			Assert::AreEqual(out.ids.size(), out.values.size(), L"Inconsistent sparse representation.");
+			std::vector<DeepLearning::Real> out_dense(reference_out.size());
+			for (auto element_id = 0ull; element_id < out.ids.size(); ++element_id)
+			{
+				Assert::IsTrue(out.values[element_id] != 0, L"Zero elements are not supposed to be stored.");
+				out_dense[out.ids[element_id]] = out.values[element_id];
+			}
+
+			Assert::IsTrue(reference_out.to_stdvector() == out_dense, L"Outputs must be the same");
+		}
+
+		TEST_METHOD(BufferConversionChessStandardTest)
+		{
+			check_buffer_conversion(StateConversionType::ChessStandard);
+		}
+
+		TEST_METHOD(BufferConversionCheckersStandardTest)
+		{
+			check_buffer_conversion(StateConversionType::CheckersStandard);
+		}
+
+		TEST_METHOD(SparseConversionChessStandardTest)
+		{
+			check_sparse_conversion(StateConversionType::ChessStandard);
+		}
+
+		TEST_METHOD(SparseConversionCheckersStandardTest)
+		{
+			check_sparse_conversion(StateConversionType::CheckersStandard);
+		}
 	};
 }
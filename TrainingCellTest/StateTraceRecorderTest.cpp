@@ -18,6 +18,7 @@
 #include "CppUnitTest.h"
 #include "../TrainingCell/Headers/StateHandleGeneral.h"
 #include "../TrainingCell/Headers/Chess/ChessState.h"
+#include "../TrainingCell/Headers/Checkers/CheckersState.h"
 #include "../DeepLearning/DeepLearning/Utilities.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -82,5 +83,36 @@ namespace TrainingCellTest
 			Assert::IsTrue(stalemates_counter > 0.03 * episodes_count, L"too low percentage of stalemates.");
 			Assert::IsTrue(checkmates_counter > 0.06 * episodes_count, L"too low percentage of checkmates.");
 		}
+
+		TEST_METHOD(ValidateRecordedStateOfReusedHandle)
+		{
+			constexpr auto episodes_count = 100;
+			const auto start_state = Checkers::CheckersState::get_start_state();
+			std::unique_ptr<IState> state_ptr;
+			const IState* first_state_ptr = nullptr;
+
+			for (auto iter_id = 0; iter_id < episodes_count; ++iter_id)
+			{
+				// Arrange
+				start_state.yield(state_ptr, true /*initialize recorder*/);
+
+				if (first_state_ptr == nullptr)
+					first_state_ptr = state_ptr.get();
+
+				// Act
+				const auto passed_sates = play_episode(*state_ptr);
+
+				// Assert
+				Assert::IsTrue(first_state_ptr == state_ptr.get(), L"State handle was not reused.");
+
+				auto recorded_state_ptr = state_ptr->get_recorded_state();
+				Assert::IsNotNull(recorded_state_ptr.get(), L"State trace was not recorded");
+
+				const auto double_passed_states = play_episode(*recorded_state_ptr);
+
+				Assert::IsTrue(passed_sates == double_passed_states, L"Passed and double-passed states are not the same.");
+				Assert::IsTrue(recorded_state_ptr->is_draw() == state_ptr->is_draw(), L"Final draw flags are not the same.");
+			}
+		}
 	};
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "CppUnitTest.h"
 #include "../TrainingCell/Headers/Board.h"
 #include "../TrainingCell/Headers/TdLambdaAgent.h"
+#include "../TrainingCell/Headers/EvaluationScheduler.h"
 #include "../TrainingCell/Headers/Checkers/StateHandle.h"
 #include "../TrainingCell/Headers/Checkers/CheckersState.h"
 #include "../DeepLearning/DeepLearning/MsgPackUtils.h"
@@ -282,5 +283,88 @@ namespace TrainingCellTest
 			Assert::IsTrue(search_settings_default == search_settings_performance_evaluation_mode,
 				L"Search settings should be independent on the performance evaluation mode of the agent.");
 		}
+
+		TEST_METHOD(TdLambdaAgentCoroutineTrainingTest)
+		{
+			// Arrange
+			const std::filesystem::path base_path = "TestData/TdlTrainingRegression";
+			auto agent0 = TdLambdaAgent::load_from_file(base_path / "agent0.tda");
+			auto agent1 = TdLambdaAgent::load_from_file(base_path / "agent1.tda");
+			auto agent0_coroutine = agent0;
+			auto agent1_coroutine = agent1;
+			constexpr int episodes = 20;
+			constexpr unsigned int seed = 7;
+
+			// Act
+			TdLambdaAgent::reset_explorer(seed);
+			Board::play(&agent0, &agent1, episodes, CheckersState::get_start_state());
+
+			TdLambdaAgent::reset_explorer(seed);
+			EvaluationScheduler scheduler;
+			Board::play({ { &agent0_coroutine, &agent1_coroutine } }, episodes, CheckersState::get_start_state(),
+				200, scheduler);
+
+			// Assert
+			Assert::IsTrue(agent0 == agent0_coroutine, L"0th agent is trained differently in the coroutine mode");
+			Assert::IsTrue(agent1 == agent1_coroutine, L"1st agent is trained differently in the coroutine mode");
+		}
+
+		TEST_METHOD(TdLambdaAgentSinglePassTrainingTest)
+		{
+			// Arrange
+			const std::filesystem::path base_path = "TestData/TdlTrainingRegression";
+			auto agent0 = TdLambdaAgent::load_from_file(base_path / "agent0.tda");
+			auto agent1 = TdLambdaAgent::load_from_file(base_path / "agent1.tda");
+			auto agent0_single_pass = agent0;
+			auto agent1_single_pass = agent1;
+			constexpr int episodes = 20;
+			constexpr unsigned int seed = 7;
+
+			// Act
+			TdLambdaAgent::reset_explorer(seed);
+			Board::train(&agent0, &agent1, episodes, CheckersState::get_start_state());
+
+			TdLambdaAgent::reset_explorer(seed);
+			Board::train(&agent0_single_pass, &agent1_single_pass, episodes, CheckersState::get_start_state(),
+				200, Board::DefaultMaxConsequentDrawEpisodes, nullptr, nullptr, nullptr, /*single pass*/ true);
+
+			// Assert
+			Assert::IsTrue(agent0 == agent0_single_pass, L"0th agent is trained differently in the single-pass mode");
+			Assert::IsTrue(agent1 == agent1_single_pass, L"1st agent is trained differently in the single-pass mode");
+		}
+
+		TEST_METHOD(TdLambdaAgentConcurrentCoroutinePlayTest)
+		{
+			// Arrange
+			const std::filesystem::path base_path = "TestData/TdlTrainingRegression";
+			auto agent0 = TdLambdaAgent::load_from_file(base_path / "agent0.tda");
+			auto agent1 = TdLambdaAgent::load_from_file(base_path / "agent1.tda");
+			agent0.set_performance_evaluation_mode(true);
+			agent1.set_performance_evaluation_mode(true);
+			agent0.set_training_mode(false);
+			agent1.set_training_mode(false);
+			constexpr int pairs_cnt = 4;
+			constexpr int episodes = 2 * pairs_cnt;
+			std::vector<TdLambdaAgent> agent_copies(2 * pairs_cnt);
+			std::vector<std::array<IMinimalAgent*, 2>> agent_pairs;
+
+			for (auto pair_id = 0; pair_id < pairs_cnt; ++pair_id)
+			{
+				agent_copies[2 * pair_id] = agent0;
+				agent_copies[2 * pair_id + 1] = agent1;
+				agent_pairs.push_back({ &agent_copies[2 * pair_id], &agent_copies[2 * pair_id + 1] });
+			}
+
+			// Act
+			const auto stats_reference = Board::play(&agent0, &agent1, 1, CheckersState::get_start_state());
+			EvaluationScheduler scheduler;
+			const auto stats = Board::play(agent_pairs, episodes, CheckersState::get_start_state(), 200, scheduler);
+
+			// Assert (the agents are deterministic, so that all the games must be the same)
+			Assert::AreEqual(episodes * stats_reference.whites_win_count(), stats.whites_win_count(),
+				L"Unexpected number of white wins.");
+			Assert::AreEqual(episodes * stats_reference.blacks_win_count(), stats.blacks_win_count(),
+				L"Unexpected number of black wins.");
+		}
 	};
 }
\ No newline at end of file
@@ -85,6 +85,11 @@ namespace TrainingCellTest
 			result.set_td_search_iterations(1234);
 			result.set_search_depth(321);
 			result.set_performance_evaluation_mode(true);
+			result.set_replay_capacity(4096);
+			result.set_replay_batch_size(16);
+			result.set_replay_interval(3);
+			result.set_replay_prioritized(true);
+			result.set_episode_batched_training(true);
 
 			return result;
 		}
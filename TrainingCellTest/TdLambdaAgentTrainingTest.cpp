@@ -21,6 +21,7 @@
 #include "../TrainingCell/Headers/RandomAgent.h"
 #include "../TrainingCell/Headers/TdLambdaAgent.h"
 #include "../TrainingCell/Headers/TdlEnsembleAgent.h"
+#include "../TrainingCell/Headers/TrainingEngine.h"
 #include "../TrainingCell/Headers/Checkers/StateHandle.h"
 #include "../TrainingCell/Headers/Checkers/CheckersState.h"
 #include "../DeepLearning/DeepLearning/MsgPackUtils.h"
@@ -188,6 +189,80 @@ namespace TrainingCellTest
 			assess_performance(agent, 0.935);
 		}
 
+		TEST_METHOD(TdLambdaAgentHogwildAutoTraining)
+		{
+			TdLambdaAgent agent({ 64, 32, 16, 8 }, 0.05, 0.15, 0.97, 0.025, StateTypeId::CHECKERS);
+			constexpr int threads_cnt = 4;
+			TrainingEngine::train_hogwild(agent, 5000, threads_cnt);
+			agent.set_exploration_probability(-1);
+			agent.set_learning_rate(0.01);
+			TrainingEngine::train_hogwild(agent, 2000, threads_cnt);
+			agent.set_learning_rate(0.001);
+			TrainingEngine::train_hogwild(agent, 2000, threads_cnt);
+			prepare_for_performance_test(agent);
+
+			//Assert
+			assess_performance(agent, 0.9);
+		}
+
+		TEST_METHOD(TdLambdaAgentActorLearnerAutoTraining)
+		{
+			TdLambdaAgent agent({ 64, 32, 16, 8 }, 0.05, 0.15, 0.97, 0.025, StateTypeId::CHECKERS);
+			constexpr int actors_cnt = 4;
+			constexpr int snapshot_refresh_interval = 200;
+			TrainingEngine::train_actor_learner(agent, 5000, actors_cnt, snapshot_refresh_interval);
+			agent.set_exploration_probability(-1);
+			agent.set_learning_rate(0.01);
+			TrainingEngine::train_actor_learner(agent, 2000, actors_cnt, snapshot_refresh_interval);
+			agent.set_learning_rate(0.001);
+			TrainingEngine::train_actor_learner(agent, 2000, actors_cnt, snapshot_refresh_interval);
+			prepare_for_performance_test(agent);
+
+			//Assert
+			assess_performance(agent, 0.88);
+		}
+
+		TEST_METHOD(TdLambdaAgentLockstepAutoTraining)
+		{
+			TdLambdaAgent agent({ 64, 32, 16, 8 }, 0.05, 0.15, 0.97, 0.025, StateTypeId::CHECKERS);
+			constexpr int games_cnt = 16;
+			TrainingEngine::train_lockstep(agent, 5000, games_cnt);
+			agent.set_exploration_probability(-1);
+			agent.set_learning_rate(0.01);
+			TrainingEngine::train_lockstep(agent, 2000, games_cnt);
+			agent.set_learning_rate(0.001);
+			TrainingEngine::train_lockstep(agent, 2000, games_cnt);
+			prepare_for_performance_test(agent);
+
+			//Assert
+			assess_performance(agent, 0.88);
+		}
+
+		TEST_METHOD(TdLambdaAgentEpisodeBatchedAutoTraining)
+		{
+			TdLambdaAgent agent({ 64, 32, 16, 8 }, 0.05, 0.15, 0.97, 0.025, StateTypeId::CHECKERS);
+			agent.set_episode_batched_training(true);
+			train_agent_standard(agent, 5000, TrainingMode::BOTH);
+			prepare_for_performance_test(agent);
+
+			//Assert
+			assess_performance(agent, 0.88);
+		}
+
+		TEST_METHOD(TdLambdaAgentExperienceReplayAutoTraining)
+		{
+			TdLambdaAgent agent({ 64, 32, 16, 8 }, 0.05, 0.15, 0.97, 0.025, StateTypeId::CHECKERS);
+			agent.set_replay_capacity(10000);
+			agent.set_replay_batch_size(16);
+			agent.set_replay_interval(4);
+			// reused experience should compensate for the reduced number of episodes with exploration
+			train_agent_standard(agent, 2500, TrainingMode::BOTH);
+			prepare_for_performance_test(agent);
+
+			//Assert
+			assess_performance(agent, 0.88);
+		}
+
 		TEST_METHOD(TdLambdaAgentAutoTrainingWhiteOnly)
 		{
 			auto agent = train_agent_standard(5000, TrainingMode::BOTH, AutoTrainingSubMode::WHITE_ONLY);
@@ -42,6 +42,15 @@ namespace Training::Modes
 		str += std::to_string(_smart_training);
 		str += std::to_string(_remove_outliers);
 
+		if (_hogwild_threads != 0) // to keep hashes of the "legacy" argument sets intact
+			str += std::to_string(_hogwild_threads);
+
+		if (_actor_threads != 0)
+			str += "A" + std::to_string(_actor_threads);
+
+		if (_lockstep_games != 0)
+			str += "L" + std::to_string(_lockstep_games);
+
 		return DeepLearning::Utils::get_hash_as_hex_str(str);
 	}
 
@@ -124,6 +133,21 @@ namespace Training::Modes
 					"the agents in a round will be substituted with a copy of best-score agent in the round.", false, false, "bool");
 		cmd.add(remove_outliers_arg);
 
+		auto hogwild_threads_arg = TCLAP::ValueArg<unsigned int>("", "hogwild_threads",
+			"If positive, each agent will be trained (in the auto-training mode) by the given number of threads "
+			"that concurrently update the weights of the agent without synchronization.", false, 0, "unsigned int");
+		cmd.add(hogwild_threads_arg);
+
+		auto actor_threads_arg = TCLAP::ValueArg<unsigned int>("", "actor_threads",
+			"If positive, each agent will be trained (in the auto-training mode) by a single learner thread "
+			"on the experience produced by the given number of actor threads that play with a snapshot of the agent's net.", false, 0, "unsigned int");
+		cmd.add(actor_threads_arg);
+
+		auto lockstep_games_arg = TCLAP::ValueArg<unsigned int>("", "lockstep_games",
+			"If positive, each agent will be trained (in the auto-training mode) by playing the given number of games in lockstep, "
+			"so that afterstates of all the games are evaluated in a single batch.", false, 0, "unsigned int");
+		cmd.add(lockstep_games_arg);
+
 		cmd.parse(argc, argv);
 
 		_source_path = source_path_arg.getValue();
@@ -171,6 +195,18 @@ namespace Training::Modes
 
 		_remove_outliers = remove_outliers_arg.getValue();
 
+		_hogwild_threads = hogwild_threads_arg.getValue();
+		if (_hogwild_threads != 0 && (!_auto_training || _smart_training))
+			throw std::exception("Hogwild training is supported only in the auto-training mode without smart training");
+
+		_actor_threads = actor_threads_arg.getValue();
+		if (_actor_threads != 0 && (!_auto_training || _smart_training || _hogwild_threads != 0))
+			throw std::exception("Actor-learner training is supported only in the auto-training mode without smart and Hogwild training");
+
+		_lockstep_games = lockstep_games_arg.getValue();
+		if (_lockstep_games != 0 && (!_auto_training || _smart_training || _hogwild_threads != 0 || _actor_threads != 0))
+			throw std::exception("Lockstep training is supported only in the auto-training mode without smart, Hogwild and actor-learner training");
+
 		_hash = calc_hash();
 	}
 
@@ -178,9 +214,9 @@ namespace Training::Modes
 	{
 		return std::format(" Source Path: {}\n Adjustments Path: {}\n Rounds: {}\n Episodes per round: {}\n"
 					 " Evaluation episodes per round: {}\n Output folder: {}\n"
-			" Fixed pairs: {}\n Auto training: {}\n Dump Rounds: {}\n Save Rounds: {}\n Smart Training: {}\n Remove Outliers: {}\n Hash: {}\n",
+			" Fixed pairs: {}\n Auto training: {}\n Dump Rounds: {}\n Save Rounds: {}\n Smart Training: {}\n Remove Outliers: {}\n Hogwild threads: {}\n Actor threads: {}\n Lockstep games: {}\n Hash: {}\n",
 			_source_path.string(), _adjustments_path.string(), _num_rounds, _num_episodes, _num_eval_episodes, _output_folder.string(),
-			_fixed_pairs, _auto_training, _dump_rounds, _save_rounds, _smart_training, _remove_outliers, _hash);
+			_fixed_pairs, _auto_training, _dump_rounds, _save_rounds, _smart_training, _remove_outliers, _hogwild_threads, _actor_threads, _lockstep_games, _hash);
 	}
 
 	bool ArgumentsTraining::get_fixed_pairs() const
@@ -227,4 +263,19 @@ namespace Training::Modes
 	{
 		return _remove_outliers;
 	}
+
+	unsigned ArgumentsTraining::get_hogwild_threads() const
+	{
+		return _hogwild_threads;
+	}
+
+	unsigned ArgumentsTraining::get_actor_threads() const
+	{
+		return _actor_threads;
+	}
+
+	unsigned ArgumentsTraining::get_lockstep_games() const
+	{
+		return _lockstep_games;
+	}
 }
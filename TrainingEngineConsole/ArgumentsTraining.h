@@ -97,6 +97,21 @@ namespace Training::Modes
 		/// by a copy of an agent with the best score in the round.
 		/// </summary>
 		bool _remove_outliers{};
+
+		/// <summary>
+		/// Number of threads to train each agent in the "Hogwild" auto-training mode (zero means that the mode is off).
+		/// </summary>
+		unsigned int _hogwild_threads{};
+
+		/// <summary>
+		/// Number of actor threads to train each agent in the "actor-learner" auto-training mode (zero means that the mode is off).
+		/// </summary>
+		unsigned int _actor_threads{};
+
+		/// <summary>
+		/// Number of games each agent plays in lockstep in the "lockstep" auto-training mode (zero means that the mode is off).
+		/// </summary>
+		unsigned int _lockstep_games{};
 	public:
 
 		/// <summary>
@@ -183,6 +198,21 @@ namespace Training::Modes
 		/// Read-only access to the corresponding field
 		/// </summary>
 		[[nodiscard]] bool get_remove_outliers() const;
+
+		/// <summary>
+		/// Read-only access to the corresponding field
+		/// </summary>
+		[[nodiscard]] unsigned int get_hogwild_threads() const;
+
+		/// <summary>
+		/// Read-only access to the corresponding field
+		/// </summary>
+		[[nodiscard]] unsigned int get_actor_threads() const;
+
+		/// <summary>
+		/// Read-only access to the corresponding field
+		/// </summary>
+		[[nodiscard]] unsigned int get_lockstep_games() const;
 	};
 }
 
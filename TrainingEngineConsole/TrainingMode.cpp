@@ -205,7 +205,25 @@ namespace Training::Modes
 			report_memory_usage();
 		};
 
-		if (args.get_auto_training())
+		if (args.get_hogwild_threads() != 0)
+		{
+			engine.run_auto_hogwild(static_cast<int>(state.get_round_id()), max_round_id,
+				static_cast<int>(args.get_num_episodes()), reporter, static_cast<int>(args.get_hogwild_threads()),
+				static_cast<int>(args.get_num_eval_episodes()), args.get_remove_outliers());
+		}
+		else if (args.get_actor_threads() != 0)
+		{
+			engine.run_auto_actor_learner(static_cast<int>(state.get_round_id()), max_round_id,
+				static_cast<int>(args.get_num_episodes()), reporter, static_cast<int>(args.get_actor_threads()),
+				/*snapshot refresh interval*/ 1000, static_cast<int>(args.get_num_eval_episodes()), args.get_remove_outliers());
+		}
+		else if (args.get_lockstep_games() != 0)
+		{
+			engine.run_auto_lockstep(static_cast<int>(state.get_round_id()), max_round_id,
+				static_cast<int>(args.get_num_episodes()), reporter, static_cast<int>(args.get_lockstep_games()),
+				static_cast<int>(args.get_num_eval_episodes()), args.get_remove_outliers());
+		}
+		else if (args.get_auto_training())
 		{
 			engine.run_auto(static_cast<int>(state.get_round_id()), max_round_id,
 				static_cast<int>(args.get_num_episodes()), reporter,